@@ -0,0 +1 @@
+zconf.hash.c_shipped
\ No newline at end of file
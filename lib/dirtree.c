@@ -4,6 +4,7 @@
  */
 
 #include "toys.h"
+#include <sys/syscall.h>
 
 static int notdotdot(char *name)
 {
@@ -20,40 +21,173 @@ int dirtree_notdotdot(struct dirtree *catch)
   return notdotdot(catch->name)*(DIRTREE_SAVE|DIRTREE_RECURSE);
 }
 
-// Create a dirtree node from a path, with stat and symlink info.
-// (This doesn't open directory filehandles yet so as not to exhaust the
-// filehandle space on large trees, dirtree_handle_callback() does that.)
+// Read directory entries in big batches. (musl's readdir() only asks the
+// kernel for 2k at a time.) Each name is good until the next dirread_next().
 
-struct dirtree *dirtree_add_node(struct dirtree *parent, char *name, int flags)
+#define DIRREAD_SIZE 65536
+
+struct dirread {
+  int fd, pos, len;
+  DIR *dir;
+  char buf[];
+};
+
+static struct dirread *dirread_open(int fd)
+{
+  struct dirread *dr;
+
+#ifdef SYS_getdents64
+  dr = xmalloc(sizeof(struct dirread)+DIRREAD_SIZE);
+  dr->fd = fd;
+  dr->pos = 0;
+  dr->dir = 0;
+  if (0>(dr->len = syscall(SYS_getdents64, fd, dr->buf, DIRREAD_SIZE))) {
+#else
+  dr = xzalloc(sizeof(struct dirread));
+  dr->fd = fd;
+  if (!(dr->dir = fdopendir(fd))) {
+#endif
+    free(dr);
+
+    return 0;
+  }
+
+  return dr;
+}
+
+// Return next name in directory (setting *type to its d_type), or NULL at end.
+static char *dirread_next(struct dirread *dr, int *type)
+{
+#ifdef SYS_getdents64
+  struct {
+    long long ino, off;
+    unsigned short reclen;
+    unsigned char type;
+    char name[];
+  } *de;
+
+  if (dr->pos>=dr->len) {
+    if (1>(dr->len = syscall(SYS_getdents64, dr->fd, dr->buf, DIRREAD_SIZE)))
+      return 0;
+    dr->pos = 0;
+  }
+  de = (void *)(dr->buf+dr->pos);
+  dr->pos += de->reclen;
+  *type = de->type;
+
+  return de->name;
+#else
+  struct dirent *de = readdir(dr->dir);
+
+  if (!de) return 0;
+  *type = de->d_type;
+
+  return de->d_name;
+#endif
+}
+
+// Closes the filehandle too.
+static void dirread_close(struct dirread *dr)
+{
+  if (dr->dir) closedir(dr->dir);
+  else close(dr->fd);
+  free(dr);
+}
+
+// DIRTREE_SLAB nodes are carved out of 64k aligned slabs, so finding a
+// node's slab is a mask. Each slab counts its live nodes and is freed when
+// the last one goes, except the one we're currently allocating from, which
+// is just reset. Single threaded, DIRTREE_PARALLEL nodes use malloc().
+
+#define DIRTREE_SLABSIZE 65536
+
+struct dirslab {
+  long used, live;
+};
+
+static struct dirslab *dirslab;
+
+static struct dirtree *dirslab_alloc(long len)
+{
+  struct dirtree *dt;
+
+  len = (len+15)&~15;
+  if (!dirslab || dirslab->used+len>DIRTREE_SLABSIZE) {
+    if (dirslab && !dirslab->live) free(dirslab);
+    if (posix_memalign((void *)&dirslab, DIRTREE_SLABSIZE, DIRTREE_SLABSIZE))
+      error_exit("xmalloc(%ld)", (long)DIRTREE_SLABSIZE);
+    dirslab->used = (sizeof(struct dirslab)+15)&~15;
+    dirslab->live = 0;
+  }
+  dt = (void *)(dirslab->used+(char *)dirslab);
+  dirslab->used += len;
+  dirslab->live++;
+  memset(dt, 0, len);
+  dt->slab = 1;
+
+  return dt;
+}
+
+// Free a node from dirtree_add_node(), dirtree_read() and friends.
+
+void dirtree_free(struct dirtree *node)
+{
+  struct dirslab *slab;
+
+  if (!node || !node->slab) free(node);
+  else if (!--(slab = (void *)(~(long)(DIRTREE_SLABSIZE-1)&(long)node))->live)
+  {
+    if (slab == dirslab) slab->used = (sizeof(struct dirslab)+15)&~15;
+    else free(slab);
+  }
+}
+
+// Stat name (relative to dirfd) and allocate a node with the stat and
+// symlink info, or return NULL with errno set. With DIRTREE_STATLESS, a type
+// from readdir() other than directory or symlink is taken instead of a stat.
+// Doesn't use libbuf, so DIRTREE_PARALLEL worker threads can call it too.
+
+static struct dirtree *dirtree_stat(int dirfd, char *name, int type, int flags)
 {
-  struct dirtree *dt = NULL;
+  struct dirtree *dt;
   struct stat st;
-  int len = 0, linklen = 0;
+  char buf[4096];
+  int len = 0, linklen = 0, nostat = 0;
 
   if (name) {
-    // open code this because haven't got node to call dirtree_parentfd() on yet
-    int fd = parent ? parent->dirfd : AT_FDCWD;
-
-    if (fstatat(fd, name, &st, AT_SYMLINK_NOFOLLOW*!(flags&DIRTREE_SYMFOLLOW)))
-      goto error;
+    if ((flags&DIRTREE_STATLESS) && type!=DT_UNKNOWN && type!=DT_DIR
+      && type!=DT_LNK)
+    {
+      memset(&st, 0, sizeof(st));
+      st.st_mode = DTTOIF(type);
+      nostat++;
+    } else if (fstatat(dirfd, name, &st,
+      AT_SYMLINK_NOFOLLOW*!(flags&DIRTREE_SYMFOLLOW))) return 0;
     if (S_ISLNK(st.st_mode)) {
-      if (0>(linklen = readlinkat(fd, name, libbuf, 4095))) goto error;
-      libbuf[linklen++]=0;
+      if (0>(linklen = readlinkat(dirfd, name, buf, 4095))) return 0;
+      buf[linklen++]=0;
     }
     len = strlen(name);
   }
-  dt = xzalloc((len = sizeof(struct dirtree)+len+1)+linklen);
-  dt->parent = parent;
+  len = sizeof(struct dirtree)+len+1;
+  if ((flags&(DIRTREE_SLAB|DIRTREE_PARALLEL)) == DIRTREE_SLAB)
+    dt = dirslab_alloc(len+linklen);
+  else dt = xzalloc(len+linklen);
   if (name) {
     memcpy(&(dt->st), &st, sizeof(struct stat));
+    dt->nostat = nostat;
     strcpy(dt->name, name);
 
-    if (linklen) dt->symlink = memcpy(len+(char *)dt, libbuf, linklen);
+    if (linklen) dt->symlink = memcpy(len+(char *)dt, buf, linklen);
   }
 
   return dt;
+}
+
+// Complain about a child of parent we couldn't stat (errno set).
 
-error:
+static void dirtree_error(struct dirtree *parent, char *name, int flags)
+{
   if (!(flags&DIRTREE_SHUTUP) && notdotdot(name)) {
     char *path = parent ? dirtree_path(parent, 0) : "";
 
@@ -61,7 +195,35 @@ error:
     if (parent) free(path);
   }
   if (parent) parent->symlink = (char *)1;
-  free(dt);
+}
+
+// Create a dirtree node from a path, with stat and symlink info.
+// (This doesn't open directory filehandles yet so as not to exhaust the
+// filehandle space on large trees, dirtree_handle_callback() does that.)
+
+struct dirtree *dirtree_add_node(struct dirtree *parent, char *name, int flags)
+{
+  struct dirtree *dt = dirtree_stat(parent ? parent->dirfd : AT_FDCWD, name,
+    DT_UNKNOWN, flags);
+
+  if (!dt) dirtree_error(parent, name, flags);
+  else dt->parent = parent;
+
+  return dt;
+}
+
+// Fill out the rest of node->st if DIRTREE_STATLESS skipped the stat().
+// Returns 0 on success, else -1 with errno set. Needs parent's dirfd, so
+// call it from the callback.
+
+int dirtree_restat(struct dirtree *node)
+{
+  if (node->nostat) {
+    if (fstatat(dirtree_parentfd(node), node->name, &node->st,
+      AT_SYMLINK_NOFOLLOW)) return -1;
+    node->nostat = 0;
+  }
+
   return 0;
 }
 
@@ -96,15 +258,309 @@ int dirtree_parentfd(struct dirtree *node)
   return node->parent ? node->parent->dirfd : AT_FDCWD;
 }
 
-// Handle callback for a node in the tree. Returns saved node(s) if
-// callback returns DIRTREE_SAVE, otherwise frees consumed nodes and
-// returns NULL. If !callback return top node unchanged.
-// If !new return DIRTREE_ABORTVAL
+// DIRTREE_PARALLEL: a pool of worker threads stats the entries of the
+// directory we're in, and lists and stats the next few subdirectories ahead
+// of us (unless DIRTREE_NOAHEAD, or there's only one cpu to do it on).
+// Callbacks still happen in this thread, in readdir() order.
+
+#define DIRTREE_AHEAD 64
+
+struct dirscan {
+  struct dirscan *next;
+  struct dirtree *node;
+  struct dirread *dir;
+  int parentfd, fd, flags, err;
+  char listed;  // 0 = not yet, 1 = worker is reading it, 2 = done
+  long count, claimed, finished, ahead;
+  char *names, *types, *done;
+  long *name;
+  int *errs;
+  struct dirtree **nodes;
+  struct dirscan **sub;
+};
+
+static struct {
+  pthread_mutex_t mutex;
+  pthread_cond_t work, done;
+  struct dirscan *queue;
+  int threads, ahead, waiting, cpus;
+} dtp = {PTHREAD_MUTEX_INITIALIZER, PTHREAD_COND_INITIALIZER,
+  PTHREAD_COND_INITIALIZER};
+
+// Read all names out of directory (opening it first if we're reading ahead).
+static void dirscan_list(struct dirscan *ds)
+{
+  char *entry;
+  long len = 0, used = 0, size = 0, i;
+  int type;
 
-struct dirtree *dirtree_handle_callback(struct dirtree *new,
-          int (*callback)(struct dirtree *node))
+  if (ds->fd == -1) ds->fd = openat(ds->parentfd, ds->node->name, O_CLOEXEC);
+  if (ds->fd == -1 || !(ds->dir = dirread_open(ds->fd))) {
+    ds->err = errno;
+
+    return;
+  }
+  while ((entry = dirread_next(ds->dir, &type))) {
+    if (!(len&63)) {
+      ds->name = xrealloc(ds->name, (len+64)*sizeof(long));
+      ds->types = xrealloc(ds->types, len+64);
+    }
+    i = strlen(entry)+1;
+    if (used+i>size) ds->names = xrealloc(ds->names, size = 2*(used+i)+4096);
+    ds->types[len] = type;
+    memcpy(ds->names+(ds->name[len++] = used), entry, i);
+    used += i;
+  }
+  ds->nodes = xzalloc(len*sizeof(struct dirtree *));
+  ds->sub = xzalloc(len*sizeof(struct dirscan *));
+  ds->errs = xzalloc(len*sizeof(int));
+  ds->done = xzalloc(len);
+  ds->count = len;
+}
+
+static void dirscan_stat(struct dirscan *ds, long i)
+{
+  if ((ds->nodes[i] = dirtree_stat(ds->fd, ds->names+ds->name[i],
+    ds->types[i], ds->flags)))
+    ds->nodes[i]->parent = ds->node;
+  else ds->errs[i] = errno;
+}
+
+// Take one piece of work from ds: list it, or stat the next batch of
+// entries. Called and returns with mutex held. The done flags are set
+// without the lock, so the caller waiting on one can check it without one.
+static void dirscan_work(struct dirscan *ds)
+{
+  long i, n, end;
+
+  if (!ds->listed) {
+    ds->listed = 1;
+    pthread_mutex_unlock(&dtp.mutex);
+    dirscan_list(ds);
+    pthread_mutex_lock(&dtp.mutex);
+    ds->listed = 2;
+    pthread_cond_broadcast(&dtp.work);
+  } else {
+    i = ds->claimed;
+    n = ds->count-i;
+    if (n>16) n = 16;
+    end = ds->claimed += n;
+    pthread_mutex_unlock(&dtp.mutex);
+    for (; i<end; i++) {
+      dirscan_stat(ds, i);
+      __atomic_store_n(ds->done+i, 1, __ATOMIC_RELEASE);
+    }
+    pthread_mutex_lock(&dtp.mutex);
+    ds->finished += n;
+  }
+  if (dtp.waiting) pthread_cond_broadcast(&dtp.done);
+}
+
+static void dirscan_wait(void)
+{
+  dtp.waiting++;
+  pthread_cond_wait(&dtp.done, &dtp.mutex);
+  dtp.waiting--;
+}
+
+static void *dirtree_worker(void *arg)
+{
+  struct dirscan *ds, **prev;
+
+  pthread_mutex_lock(&dtp.mutex);
+  for (;;) {
+    // Drop scans with nothing left to hand out, use the first with work.
+    for (prev = &dtp.queue; (ds = *prev);) {
+      if (!ds->listed || (ds->listed==2 && ds->claimed<ds->count)) break;
+      if (ds->listed==2) *prev = ds->next;
+      else prev = &ds->next;
+    }
+    if (ds) dirscan_work(ds);
+    else pthread_cond_wait(&dtp.work, &dtp.mutex);
+  }
+
+  return 0;
+}
+
+// Queue scan of node's directory. If fd is -1, a worker opens and lists it,
+// else caller lists it and sets ->listed to 2 when done.
+static struct dirscan *dirscan_new(struct dirtree *node, int fd, int flags)
+{
+  struct dirscan *ds = xzalloc(sizeof(struct dirscan));
+  pthread_t thread;
+
+  ds->node = node;
+  ds->parentfd = dirtree_parentfd(node);
+  ds->fd = fd;
+  ds->flags = flags;
+  ds->listed = fd != -1;
+
+  pthread_mutex_lock(&dtp.mutex);
+  if (!dtp.threads) {
+    long cpus = dtp.cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    // Mostly waiting on the filesystem, so more threads than cpus.
+    for (dtp.threads = cpus<2 ? 2 : cpus>8 ? 32 : 4*cpus;
+      dtp.threads--;) {
+      xpthread_create(&thread, dirtree_worker, 0);
+      pthread_detach(thread);
+    }
+    dtp.threads = 1;
+  }
+  ds->next = dtp.queue;
+  dtp.queue = ds;
+  pthread_cond_signal(&dtp.work);
+  pthread_mutex_unlock(&dtp.mutex);
+
+  return ds;
+}
+
+// Wait for workers to finish with ds, then free it and anything unused.
+static void dirscan_free(struct dirscan *ds)
+{
+  struct dirscan **prev;
+  long i;
+
+  if (!ds) return;
+  pthread_mutex_lock(&dtp.mutex);
+  for (prev = &dtp.queue; *prev; prev = &(*prev)->next)
+    if (*prev == ds) {
+      *prev = ds->next;
+      break;
+    }
+  while (ds->listed==1 || ds->finished<ds->claimed)
+    dirscan_wait();
+  pthread_mutex_unlock(&dtp.mutex);
+
+  for (i = 0; i<ds->count; i++) {
+    dirtree_free(ds->nodes[i]);
+    if (ds->sub[i]) {
+      dirscan_free(ds->sub[i]);
+      pthread_mutex_lock(&dtp.mutex);
+      dtp.ahead--;
+      pthread_mutex_unlock(&dtp.mutex);
+    }
+  }
+  if (ds->dir) dirread_close(ds->dir);
+  else if (ds->fd != -1) close(ds->fd);
+  free(ds->names);
+  free(ds->types);
+  free(ds->name);
+  free(ds->nodes);
+  free(ds->sub);
+  free(ds->errs);
+  free(ds->done);
+  free(ds);
+}
+
+static struct dirtree *dirtree_callback(struct dirtree *new,
+  int (*callback)(struct dirtree *node), struct dirscan *sub);
+
+// Process children of directory node using worker threads, taking over
+// a scan already in progress if there is one.
+
+static int dirtree_precurse(struct dirtree *node,
+  int (*callback)(struct dirtree *node), int flags, struct dirscan *ds)
 {
-  int flags;
+  struct dirtree *new, **ddt = &(node->child);
+  long i, j;
+
+  if (!ds) {
+    if (node->dirfd != -1) {
+      ds = dirscan_new(node, node->dirfd, flags);
+      dirscan_list(ds);
+      pthread_mutex_lock(&dtp.mutex);
+      ds->listed = 2;
+      pthread_cond_broadcast(&dtp.work);
+      pthread_mutex_unlock(&dtp.mutex);
+    }
+  } else {
+    pthread_mutex_lock(&dtp.mutex);
+    dtp.ahead--;
+    while (ds->listed != 2) {
+      if (!ds->listed) dirscan_work(ds);
+      else dirscan_wait();
+    }
+    pthread_mutex_unlock(&dtp.mutex);
+  }
+
+  if (!ds || ds->err) {
+    if (!(flags & DIRTREE_SHUTUP)) {
+      char *path = dirtree_path(node, 0);
+
+      errno = ds ? ds->err : errno;
+      perror_msg("No %s", path);
+      free(path);
+    }
+    if (ds) dirscan_free(ds);
+    else close(node->dirfd);
+    node->dirfd = -1;
+
+    return flags;
+  }
+  node->dirfd = ds->fd;
+
+  for (i = 0; i<ds->count; i++) {
+    // Wait for this entry, statting others ourselves rather than idling.
+    if (!__atomic_load_n(ds->done+i, __ATOMIC_ACQUIRE)) {
+      pthread_mutex_lock(&dtp.mutex);
+      while (!ds->done[i]) {
+        if (ds->claimed<ds->count) dirscan_work(ds);
+        else dirscan_wait();
+      }
+      pthread_mutex_unlock(&dtp.mutex);
+    }
+
+    // Start reading ahead into following subdirectories.
+    if ((flags&DIRTREE_NOAHEAD) || dtp.cpus<2) j = ds->count;
+    else j = ds->ahead>i ? ds->ahead : i+1;
+    for (; j<ds->count && __atomic_load_n(ds->done+j, __ATOMIC_ACQUIRE); j++)
+    {
+      if (!ds->nodes[j] || !S_ISDIR(ds->nodes[j]->st.st_mode)
+        || !notdotdot(ds->names+ds->name[j])) continue;
+      pthread_mutex_lock(&dtp.mutex);
+      if (dtp.ahead<DIRTREE_AHEAD) dtp.ahead++;
+      else j = -1;
+      pthread_mutex_unlock(&dtp.mutex);
+      if (j == -1) break;
+      ds->sub[j] = dirscan_new(ds->nodes[j], -1, flags);
+    }
+    if (j != -1) ds->ahead = j;
+
+    if (!(new = ds->nodes[i])) {
+      errno = ds->errs[i];
+      dirtree_error(node, ds->names+ds->name[i], flags);
+      continue;
+    }
+    ds->nodes[i] = 0;
+    new = dirtree_callback(new, callback, ds->sub[i]);
+    ds->sub[i] = 0;
+    if (new == DIRTREE_ABORTVAL) break;
+    if (new) {
+      *ddt = new;
+      ddt = &((*ddt)->next);
+    }
+  }
+
+  if (flags & DIRTREE_COMEAGAIN) {
+    node->again++;
+    flags = callback(node);
+  }
+
+  dirscan_free(ds);
+  node->dirfd = -1;
+
+  return flags;
+}
+
+// Handle callback for a node in the tree, recursing into it with the
+// read ahead scan sub if we have one.
+
+static struct dirtree *dirtree_callback(struct dirtree *new,
+  int (*callback)(struct dirtree *node), struct dirscan *sub)
+{
+  int flags, mask = DIRTREE_SYMFOLLOW|DIRTREE_SHUTUP|DIRTREE_PARALLEL
+    |DIRTREE_STATLESS;
 
   if (!new) return DIRTREE_ABORTVAL;
   if (!callback) return new;
@@ -112,20 +568,42 @@ struct dirtree *dirtree_handle_callback(struct dirtree *new,
 
   if (S_ISDIR(new->st.st_mode)) {
     if (flags & (DIRTREE_RECURSE|DIRTREE_COMEAGAIN)) {
-      new->dirfd = openat(dirtree_parentfd(new), new->name, O_CLOEXEC);
-      flags = dirtree_recurse(new, callback, flags);
+      if (sub && (flags&mask) == (sub->flags&mask)) {
+        flags = dirtree_precurse(new, callback, flags, sub);
+        sub = 0;
+      } else {
+        new->dirfd = openat(dirtree_parentfd(new), new->name, O_CLOEXEC);
+        flags = dirtree_recurse(new, callback, flags);
+      }
     }
   }
+  if (sub) {
+    dirscan_free(sub);
+    pthread_mutex_lock(&dtp.mutex);
+    dtp.ahead--;
+    pthread_mutex_unlock(&dtp.mutex);
+  }
 
   // If this had children, it was callback's job to free them already.
   if (!(flags & DIRTREE_SAVE)) {
-    free(new);
+    dirtree_free(new);
     new = NULL;
   }
 
   return (flags & DIRTREE_ABORT)==DIRTREE_ABORT ? DIRTREE_ABORTVAL : new;
 }
 
+// Handle callback for a node in the tree. Returns saved node(s) if
+// callback returns DIRTREE_SAVE, otherwise frees consumed nodes and
+// returns NULL. If !callback return top node unchanged.
+// If !new return DIRTREE_ABORTVAL
+
+struct dirtree *dirtree_handle_callback(struct dirtree *new,
+          int (*callback)(struct dirtree *node))
+{
+  return dirtree_callback(new, callback, 0);
+}
+
 // Recursively read/process children of directory node, filtering through
 // callback(). Uses and closes supplied ->dirfd.
 
@@ -133,10 +611,14 @@ int dirtree_recurse(struct dirtree *node,
           int (*callback)(struct dirtree *node), int flags)
 {
   struct dirtree *new, **ddt = &(node->child);
-  struct dirent *entry;
-  DIR *dir;
+  struct dirread *dir;
+  char *name;
+  int type;
+
+  if (flags & DIRTREE_PARALLEL)
+    return dirtree_precurse(node, callback, flags, 0);
 
-  if (node->dirfd == -1 || !(dir = fdopendir(node->dirfd))) {
+  if (node->dirfd == -1 || !(dir = dirread_open(node->dirfd))) {
     if (!(flags & DIRTREE_SHUTUP)) {
       char *path = dirtree_path(node, 0);
       perror_msg("No %s", path);
@@ -147,12 +629,13 @@ int dirtree_recurse(struct dirtree *node,
     return flags;
   }
 
-  // according to the fddir() man page, the filehandle in the DIR * can still
-  // be externally used by things that don't lseek() it.
-
-  // The extra parentheses are to shut the stupid compiler up.
-  while ((entry = readdir(dir))) {
-    if (!(new = dirtree_add_node(node, entry->d_name, flags))) continue;
+  // The filehandle can still be externally used by things that don't lseek() it.
+  while ((name = dirread_next(dir, &type))) {
+    if (!(new = dirtree_stat(node->dirfd, name, type, flags))) {
+      dirtree_error(node, name, flags);
+      continue;
+    }
+    new->parent = node;
     new = dirtree_handle_callback(new, callback);
     if (new == DIRTREE_ABORTVAL) break;
     if (new) {
@@ -167,7 +650,7 @@ int dirtree_recurse(struct dirtree *node,
   }
 
   // This closes filehandle as well, so note it
-  closedir(dir);
+  dirread_close(dir);
   node->dirfd = -1;
 
   return flags;
@@ -578,19 +578,101 @@ void loopfiles(char **argv, void (*function)(int fd, char *name))
   loopfiles_rw(argv, O_RDONLY|O_CLOEXEC, 0, 0, function);
 }
 
-// Slow, but small.
+// A file truncated while mapped gives SIGBUS when we touch the missing pages,
+// so jump back out to loopchunks() (in whichever thread faulted).
+static __thread sigjmp_buf *chunkjmp;
+
+static void chunkbus(int sig)
+{
+  if (chunkjmp) siglongjmp(*chunkjmp, 1);
+  signal(sig, SIG_DFL);
+  raise(sig);
+}
+
+// Call function() on successive chunks of fd's contents (from the current
+// position) until EOF. Regular files are mmap()ed a big window at a time so
+// the data is used straight out of page cache, anything else (or anything
+// mmap() refuses) gets large read()s. Reports read errors against name,
+// including files truncated under us.
+
+void loopchunks(int fd, char *name, void (*function)(char *data, long len))
+{
+  struct stat st;
+  struct sigaction sa;
+  sigjmp_buf jmp;
+  off_t pos, base;
+  long len, win = sizeof(long)>4 ? 1<<30 : 1<<24;
+  char *buf;
+
+  if (!fstat(fd, &st) && S_ISREG(st.st_mode)
+    && (pos = lseek(fd, 0, SEEK_CUR)) != -1)
+  {
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_handler = chunkbus;
+    sigaction(SIGBUS, &sa, 0);
+
+    // mmap() offset must be page aligned, so start window at page boundary.
+    for (base = pos&~(off_t)(sysconf(_SC_PAGESIZE)-1); pos<st.st_size;
+      base = pos)
+    {
+      len = (st.st_size-base > win) ? win : st.st_size-base;
+      buf = mmap(0, len, PROT_READ, MAP_SHARED, fd, base);
+      if (buf == MAP_FAILED) break;
+      madvise(buf, len, MADV_SEQUENTIAL);
+      if (sigsetjmp(jmp, 1)) {
+        chunkjmp = 0;
+        munmap(buf, len);
+        error_msg("%s: file truncated", name);
+
+        return;
+      }
+      chunkjmp = &jmp;
+      function(buf+(pos-base), len-(pos-base));
+      chunkjmp = 0;
+      munmap(buf, len);
+      pos = base+len;
+    }
+    lseek(fd, pos, SEEK_SET);
+  }
+
+  // Read whatever's left (pipes, /proc, files that grew or can't be mapped).
+  buf = xmalloc(len = 1<<17);
+  for (;;) {
+    long i = read(fd, buf, len);
+
+    if (i<0) perror_msg_raw(name);
+    if (i<1) break;
+    function(buf, i);
+  }
+  free(buf);
+}
+
+// Read one line (including end character) from fd. For seekable fds this
+// reads ahead and seeks back to just after the line, so the fd is left where
+// a byte at a time read would have left it. Pipes still go a byte at a time.
+// Use struct linebuf instead if you own the fd and read it to the end.
 
 char *get_rawline(int fd, long *plen, char end)
 {
-  char c, *buf = NULL;
-  long len = 0;
+  char *buf = 0, *c;
+  long len = 0, size = 0, i;
+  off_t pos = lseek(fd, 0, SEEK_CUR);
 
   for (;;) {
-    if (1>read(fd, &c, 1)) break;
-    if (!(len & 63)) buf=xrealloc(buf, len+65);
-    if ((buf[len++]=c) == end) break;
+    if (len == size) buf = xrealloc(buf, (size += size ? size : 128)+1);
+    if (1>(i = read(fd, buf+len, pos==-1 ? 1 : size-len))) break;
+    if ((c = memchr(buf+len, end, i))) {
+      if (c+1 != buf+len+i) lseek(fd, pos += c+1-buf, SEEK_SET);
+      len = c+1-buf;
+      break;
+    }
+    len += i;
+  }
+  if (len) buf[len] = 0;
+  else {
+    free(buf);
+    buf = 0;
   }
-  if (buf) buf[len]=0;
   if (plen) *plen = len;
 
   return buf;
@@ -606,6 +688,82 @@ char *get_line(int fd)
   return buf;
 }
 
+// Buffered line reader: read big blocks and memchr() for the delimiter.
+// Reads ahead, so nothing else should read the fd while this is using it.
+
+struct linebuf *linebuf_new(int fd)
+{
+  struct linebuf *lb = xzalloc(sizeof(struct linebuf));
+
+  lb->fd = fd;
+  lb->buf = xmalloc((lb->size = 65536)+1);
+
+  return lb;
+}
+
+// Return next line (including end character if any) in place in the buffer,
+// null terminated and valid until the next call. Caller may modify contents.
+// Returns NULL at EOF. Read errors are treated as EOF.
+char *linebuf_view(struct linebuf *lb, long *plen, char end)
+{
+  char *c;
+  long seen = 0, len, i;
+
+  // Put back the byte last call's null terminator replaced.
+  if (lb->start<lb->end) lb->buf[lb->start] = lb->save;
+
+  for (;;) {
+    len = lb->end-lb->start;
+    if ((c = memchr(lb->buf+lb->start+seen, end, len-seen))) {
+      len = c+1-(lb->buf+lb->start);
+      break;
+    }
+    if (lb->eof) {
+      if (len) break;
+      if (plen) *plen = 0;
+
+      return 0;
+    }
+    seen = len;
+
+    // Full buffer: slide partial line to the front, or grow if it fills it.
+    if (lb->end == lb->size) {
+      if (lb->start) {
+        memmove(lb->buf, lb->buf+lb->start, len);
+        lb->start = 0;
+        lb->end = len;
+      } else lb->buf = xrealloc(lb->buf, (lb->size *= 2)+1);
+    }
+    if (1>(i = read(lb->fd, lb->buf+lb->end, lb->size-lb->end))) lb->eof++;
+    else lb->end += i;
+  }
+  c = lb->buf+lb->start;
+  lb->start += len;
+  lb->save = c[len];
+  c[len] = 0;
+  if (plen) *plen = len;
+
+  return c;
+}
+
+// Like get_rawline() but from a linebuf: returns a malloc()ed copy.
+char *linebuf_line(struct linebuf *lb, long *plen, char end)
+{
+  long len;
+  char *c = linebuf_view(lb, &len, end);
+
+  if (plen) *plen = len;
+
+  return c ? xmemdup(c, len+1) : 0;
+}
+
+// Free linebuf (but don't close fd).
+void linebuf_free(struct linebuf *lb)
+{
+  if (lb) free(lb->buf);
+  free(lb);
+}
+
 int wfchmodat(int fd, char *name, mode_t mode)
 {
   int rc = fchmodat(fd, name, mode, 0);
@@ -688,6 +846,161 @@ void crc_init(unsigned int *crc_table, int little_endian)
   }
 }
 
+// Carry-less multiply folding of reflected crc32 (gzip/xz polynomial), from
+// Intel's "Fast CRC Computation Using PCLMULQDQ Instruction" paper. Takes
+// the raw (uninverted) crc, len must be at least 64 and a multiple of 16.
+
+#if defined(__ARM_FEATURE_CRC32)
+#include <arm_acle.h>
+#elif defined(__x86_64__) && defined(__GNUC__)
+#include <wmmintrin.h>
+
+static char crc_clmul;
+
+__attribute__((target("pclmul,sse2")))
+static unsigned crc32_clmul(unsigned crc, unsigned char *p, long len)
+{
+  static const unsigned long long k1k2[] = {0x0154442bd4, 0x01c6e41596},
+    k3k4[] = {0x01751997d0, 0x00ccaa009e}, k5k0[] = {0x0163cd6124, 0},
+    poly[] = {0x01db710641, 0x01f7011641};
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8, mask;
+
+  // Fold 4 lanes of 16 bytes in parallel
+  x1 = _mm_xor_si128(_mm_loadu_si128((void *)p), _mm_cvtsi32_si128(crc));
+  x2 = _mm_loadu_si128((void *)(p+16));
+  x3 = _mm_loadu_si128((void *)(p+32));
+  x4 = _mm_loadu_si128((void *)(p+48));
+  x0 = _mm_loadu_si128((void *)k1k2);
+  for (p += 64, len -= 64; len >= 64; p += 64, len -= 64) {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x5);
+    x2 = _mm_xor_si128(_mm_clmulepi64_si128(x2, x0, 0x11), x6);
+    x3 = _mm_xor_si128(_mm_clmulepi64_si128(x3, x0, 0x11), x7);
+    x4 = _mm_xor_si128(_mm_clmulepi64_si128(x4, x0, 0x11), x8);
+    x1 = _mm_xor_si128(x1, _mm_loadu_si128((void *)p));
+    x2 = _mm_xor_si128(x2, _mm_loadu_si128((void *)(p+16)));
+    x3 = _mm_xor_si128(x3, _mm_loadu_si128((void *)(p+32)));
+    x4 = _mm_xor_si128(x4, _mm_loadu_si128((void *)(p+48)));
+  }
+
+  // Fold lanes into one, then any remaining 16 byte blocks into that
+  x0 = _mm_loadu_si128((void *)k3k4);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x5);
+  x1 = _mm_xor_si128(x1, x2);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x5);
+  x1 = _mm_xor_si128(x1, x3);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x5);
+  x1 = _mm_xor_si128(x1, x4);
+  for (; len >= 16; p += 16, len -= 16) {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x11), x5);
+    x1 = _mm_xor_si128(x1, _mm_loadu_si128((void *)p));
+  }
+
+  // Fold 128 bits to 64, then Barrett reduce to 32
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  mask = _mm_setr_epi32(~0, 0, ~0, 0);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x0 = _mm_loadl_epi64((void *)k5k0);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  x0 = _mm_loadu_si128((void *)poly);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x1, mask), x0, 0x10);
+  x2 = _mm_clmulepi64_si128(_mm_and_si128(x2, mask), x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+
+  return _mm_cvtsi128_si32(_mm_srli_si128(x1, 4));
+}
+#endif
+
+// Create 8 256 entry CRC32 tables for slice-by-8 crc32_le()/crc32_be(),
+// the first of which is the crc_init() table.
+
+void crc32_init(unsigned *crc_table, int little_endian)
+{
+  unsigned i, j, c;
+
+  crc_init(crc_table, little_endian);
+  for (i=0; i<256; i++) for (c = crc_table[i], j=1; j<8; j++) {
+    if (little_endian) c = (c>>8)^crc_table[c&255];
+    else c = (c<<8)^crc_table[c>>24];
+    crc_table[256*j+i] = c;
+  }
+#if defined(__x86_64__) && defined(__GNUC__)
+  crc_clmul = !!__builtin_cpu_supports("pclmul");
+#endif
+}
+
+// Update crc (without pre/post inversion) with len bytes of data, using
+// a little endian table from crc32_init(). Uses ARMv8 crc instructions or
+// x86 PCLMULQDQ when available, else 8 bytes per table lookup round.
+
+unsigned crc32_le(unsigned *crc_table, unsigned crc, void *data, long len)
+{
+  unsigned char *p = data;
+  unsigned a, b;
+
+#if defined(__ARM_FEATURE_CRC32)
+  for (; len && ((long)p&7); len--) crc = __crc32b(crc, *p++);
+  for (; len>=8; len -= 8, p += 8) {
+    unsigned long long ll;
+
+    memcpy(&ll, p, 8);
+    crc = __crc32d(crc, SWAP_LE64(ll));
+  }
+#elif defined(__x86_64__) && defined(__GNUC__)
+  if (crc_clmul && len>=64) {
+    crc = crc32_clmul(crc, p, len&~15L);
+    p += len&~15L;
+    len &= 15;
+  }
+#endif
+  for (; len && ((long)p&7); len--) crc = crc_table[(crc^*p++)&255]^(crc>>8);
+  for (; len>=8; len -= 8, p += 8) {
+    memcpy(&a, p, 4);
+    memcpy(&b, p+4, 4);
+    a = crc^SWAP_LE32(a);
+    b = SWAP_LE32(b);
+    crc = crc_table[7*256+(a&255)] ^ crc_table[6*256+((a>>8)&255)]
+      ^ crc_table[5*256+((a>>16)&255)] ^ crc_table[4*256+(a>>24)]
+      ^ crc_table[3*256+(b&255)] ^ crc_table[2*256+((b>>8)&255)]
+      ^ crc_table[256+((b>>16)&255)] ^ crc_table[b>>24];
+  }
+  while (len--) crc = crc_table[(crc^*p++)&255]^(crc>>8);
+
+  return crc;
+}
+
+// Big endian version of crc32_le() (as used by cksum), table lookups only.
+
+unsigned crc32_be(unsigned *crc_table, unsigned crc, void *data, long len)
+{
+  unsigned char *p = data;
+  unsigned a, b;
+
+  for (; len && ((long)p&7); len--) crc = (crc<<8)^crc_table[(crc>>24)^*p++];
+  for (; len>=8; len -= 8, p += 8) {
+    memcpy(&a, p, 4);
+    memcpy(&b, p+4, 4);
+    a = crc^SWAP_BE32(a);
+    b = SWAP_BE32(b);
+    crc = crc_table[7*256+(a>>24)] ^ crc_table[6*256+((a>>16)&255)]
+      ^ crc_table[5*256+((a>>8)&255)] ^ crc_table[4*256+(a&255)]
+      ^ crc_table[3*256+(b>>24)] ^ crc_table[2*256+((b>>16)&255)]
+      ^ crc_table[256+((b>>8)&255)] ^ crc_table[b&255];
+  }
+  while (len--) crc = (crc<<8)^crc_table[(crc>>24)^*p++];
+
+  return crc;
+}
+
 // Init base64 table
 
 void base64_init(char *p)
@@ -1058,3 +1371,59 @@ int dev_makedev(int major, int minor)
 {
   return (minor&0xff)|((major&0xfff)<<8)|((minor&0xfff00)<<12);
 }
+
+// Open addressing hash of dev+ino. Empty slots are 0,0: inode 0 isn't valid
+// and the kernel doesn't hand out device 0.
+static struct inoset_entry *inoset_slot(struct inoset *set, dev_t dev,
+  ino_t ino)
+{
+  unsigned long long h = (ino^((unsigned long long)dev<<29))
+    *0x9e3779b97f4a7c15ULL;
+  long i = (h>>32)&(set->size-1);
+  struct inoset_entry *e;
+
+  for (;;) {
+    e = set->table+i;
+    if ((e->ino==ino && e->dev==dev) || (!e->ino && !e->dev)) return e;
+    i = (i+1)&(set->size-1);
+  }
+}
+
+// Return 1 if st's dev+ino is already in set, else add it and return 0.
+// If data isn't NULL, point it at the entry's data pointer either way (which
+// starts out NULL for new entries).
+int inoset_add(struct inoset *set, struct stat *st, void ***data)
+{
+  struct inoset_entry *e, *old = set->table;
+  long i, size = set->size;
+
+  // Keep it at most half full, growing by doubling.
+  if (2*(set->used+1)>size) {
+    set->size = size ? 2*size : 1024;
+    set->table = xzalloc(set->size*sizeof(struct inoset_entry));
+    for (i = 0; i<size; i++)
+      if (old[i].ino || old[i].dev)
+        *inoset_slot(set, old[i].dev, old[i].ino) = old[i];
+    free(old);
+  }
+
+  e = inoset_slot(set, st->st_dev, st->st_ino);
+  if (data) *data = &e->data;
+  if (e->ino || e->dev) return 1;
+  e->dev = st->st_dev;
+  e->ino = st->st_ino;
+  set->used++;
+
+  return 0;
+}
+
+// Free the table, calling freeit (if not NULL) on each non-NULL data.
+void inoset_free(struct inoset *set, void (*freeit)(void *data))
+{
+  long i;
+
+  if (freeit) for (i = 0; i<set->size; i++)
+    if (set->table[i].data) freeit(set->table[i].data);
+  free(set->table);
+  memset(set, 0, sizeof(*set));
+}
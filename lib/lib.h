@@ -64,8 +64,20 @@ void get_optflags(void);
 #define DIRTREE_SHUTUP      16
 // Breadth first traversal, conserves filehandles at the expense of memory
 #define DIRTREE_BREADTH     32
+// Stat entries and read ahead into subdirectories with worker threads
+// (callbacks still happen one at a time in the calling thread, in order)
+#define DIRTREE_PARALLEL    64
+// Skip stat() of children readdir() says aren't directories or symlinks,
+// leaving just the file type in st_mode (see dirtree_restat())
+#define DIRTREE_STATLESS   128
 // Don't look at any more files in this directory.
 #define DIRTREE_ABORT      256
+// Allocate nodes from slabs (free them with dirtree_free()), faster when
+// keeping lots of them. Ignored with DIRTREE_PARALLEL.
+#define DIRTREE_SLAB       512
+// With DIRTREE_PARALLEL, don't open subdirectories before the callback has
+// said to recurse into them (for callers that prune, stop at mount points...)
+#define DIRTREE_NOAHEAD   1024
 
 #define DIRTREE_ABORTVAL ((struct dirtree *)1)
 
@@ -75,13 +87,15 @@ struct dirtree {
   struct stat st;
   char *symlink;
   int dirfd;
-  char again;
+  char again, nostat, slab;
   char name[];
 };
 
 struct dirtree *dirtree_add_node(struct dirtree *p, char *name, int flags);
 char *dirtree_path(struct dirtree *node, int *plen);
 int dirtree_notdotdot(struct dirtree *catch);
+int dirtree_restat(struct dirtree *node);
+void dirtree_free(struct dirtree *node);
 int dirtree_parentfd(struct dirtree *node);
 int dirtree_recurse(struct dirtree *node, int (*callback)(struct dirtree *node),
   int symfollow);
@@ -149,6 +163,7 @@ void xpidfile(char *name);
 void xregcomp(regex_t *preg, char *rexec, int cflags);
 char *xtzset(char *new);
 void xsignal(int signal, void *handler);
+void xpthread_create(pthread_t *thread, void *(*func)(void *), void *arg);
 
 // lib.c
 void verror_msg(char *msg, int err, va_list va);
@@ -188,12 +203,17 @@ off_t fdlength(int fd);
 void loopfiles_rw(char **argv, int flags, int permissions, int failok,
   void (*function)(int fd, char *name));
 void loopfiles(char **argv, void (*function)(int fd, char *name));
+void loopchunks(int fd, char *name, void (*function)(char *data, long len));
 void xsendfile(int in, int out);
+int xcopyfile(int in, int out, int reflink);
 int wfchmodat(int rc, char *name, mode_t mode);
 int copy_tempfile(int fdin, char *name, char **tempname);
 void delete_tempfile(int fdin, int fdout, char **tempname);
 void replace_tempfile(int fdin, int fdout, char **tempname);
 void crc_init(unsigned int *crc_table, int little_endian);
+void crc32_init(unsigned *crc_table, int little_endian);
+unsigned crc32_le(unsigned *crc_table, unsigned crc, void *data, long len);
+unsigned crc32_be(unsigned *crc_table, unsigned crc, void *data, long len);
 void base64_init(char *p);
 int yesno(int def);
 int qstrcmp(const void *a, const void *b);
@@ -210,6 +230,31 @@ int dev_makedev(int major, int minor);
 #define HR_1000  4 // Use decimal instead of binary units
 int human_readable(char *buf, unsigned long long num, int style);
 
+// Buffered line reader, see linebuf_view()
+struct linebuf {
+  int fd, eof;
+  char *buf, save;
+  long start, end, size;
+};
+
+struct linebuf *linebuf_new(int fd);
+char *linebuf_view(struct linebuf *lb, long *plen, char end);
+char *linebuf_line(struct linebuf *lb, long *plen, char end);
+void linebuf_free(struct linebuf *lb);
+
+// Hash set of dev+ino pairs (hardlink detection), each with a data pointer
+struct inoset {
+  struct inoset_entry {
+    dev_t dev;
+    ino_t ino;
+    void *data;
+  } *table;
+  long used, size;
+};
+
+int inoset_add(struct inoset *set, struct stat *st, void ***data);
+void inoset_free(struct inoset *set, void (*freeit)(void *data));
+
 // linestack.c
 
 struct linestack {
@@ -8,6 +8,7 @@
  */
 
 #include "toys.h"
+#include <sys/syscall.h>
 
 // strcpy and strncat with size checking. Size is the total space in "dest",
 // including null terminator. Exit if there's not enough space for the string
@@ -679,6 +680,75 @@ void xsendfile(int in, int out)
   }
 }
 
+// Copy regular file in to out (a new file, both at offset 0), letting the
+// kernel do the work where it can: a FICLONE reflink sharing the blocks
+// (btrfs, xfs), else copy_file_range(), else sendfile(), else read/write.
+// Holes in in stay holes in out. reflink is 0 to never reflink, 1 to try,
+// 2 to return -1 (errno set) if we can't. Dies on I/O errors like xsendfile().
+
+int xcopyfile(int in, int out, int reflink)
+{
+  struct stat st, st2;
+  off_t pos = 0, end, opos;
+  long len;
+  int how = 0, sparse;
+  char buf[65536];
+
+  if (reflink && !ioctl(out, FICLONE, in)) return 0;
+  if (reflink == 2) return -1;
+  if (fstat(in, &st) || fstat(out, &st2) || !S_ISREG(st.st_mode)
+    || !S_ISREG(st2.st_mode)) st.st_size = 0;
+
+  // Only files with fewer blocks than their size need have holes.
+  sparse = st.st_blocks*512 < st.st_size;
+  while (pos < st.st_size) {
+    if (sparse) {
+      if (0>(end = lseek(in, pos, SEEK_DATA))) {
+        if (errno == ENXIO) break;
+        sparse = 0;
+        continue;
+      }
+      pos = end;
+      end = lseek(in, pos, SEEK_HOLE);
+      if (end<pos || end>st.st_size) end = st.st_size;
+    } else end = st.st_size;
+
+    while (pos < end) {
+      len = (end-pos > 1<<30) ? 1<<30 : end-pos;
+      opos = pos;
+      if (!how) {
+#ifdef SYS_copy_file_range
+        len = syscall(SYS_copy_file_range, in, &pos, out, &opos, len, 0);
+#else
+        len = -1;
+#endif
+      } else if (how == 1) {
+        xlseek(out, pos, SEEK_SET);
+        len = syscall(SYS_sendfile, out, in, &pos, len);
+      } else {
+        if (len>sizeof(buf)) len = sizeof(buf);
+        if (0<(len = pread(in, buf, len, pos))) {
+          if (len != pwrite(out, buf, len, pos)) perror_exit("xwrite");
+          pos += len;
+        } else if (len<0) perror_exit("xread");
+      }
+      // Fall back to the next method (the last one died on errors).
+      if (len<0) how++;
+      else if (!len) st.st_size = end = pos;
+    }
+  }
+
+  // Trailing hole, then anything the file grew (or /proc didn't mention).
+  if (st.st_size) {
+    if (ftruncate(out, st.st_size)) perror_exit("ftruncate");
+    xlseek(in, st.st_size, SEEK_SET);
+    xlseek(out, st.st_size, SEEK_SET);
+  }
+  while (0<(len = xread(in, buf, sizeof(buf)))) xwrite(out, buf, len);
+
+  return 0;
+}
+
 // parse fractional seconds with optional s/m/h/d suffix
 long xparsetime(char *arg, long units, long *fraction)
 {
@@ -737,3 +807,14 @@ void xsignal(int signal, void *handler)
 
   if (sigaction(signal, sa, 0)) perror_exit("xsignal %d", signal);
 }
+
+// Start a thread (which the caller must pthread_join() or pthread_detach())
+void xpthread_create(pthread_t *thread, void *(*func)(void *), void *arg)
+{
+  int err = pthread_create(thread, 0, func, arg);
+
+  if (err) {
+    errno = err;
+    perror_exit("pthread_create");
+  }
+}
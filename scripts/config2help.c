@@ -362,11 +362,13 @@ int main(int argc, char *argv[])
         free(cusage);
         free(tusage);
         throw->enabled = 0;
+        throw->help = 0;
         throw = catch;
         throw->help = anchor->prev->prev;
 
         throw = catch;
-        this = throw->help->data + throw->help_indent + 8 + len;
+        name = throw->help->data + throw->help_indent + 8;
+        this = name + len;
       }
     }
 
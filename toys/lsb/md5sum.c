@@ -4,51 +4,110 @@
  *
  * See http://refspecs.linuxfoundation.org/LSB_4.1.0/LSB-Core-generic/LSB-Core-generic/md5sum.html
  * and http://www.ietf.org/rfc/rfc1321.txt
+ * and http://csrc.nist.gov/publications/fips/fips180-4/fips-180-4.pdf
  *
  * They're combined this way to share infrastructure, and because md5sum is
  * and LSB standard command, sha1sum is just a good idea.
 
-USE_MD5SUM(NEWTOY(md5sum, "b", TOYFLAG_USR|TOYFLAG_BIN))
-USE_SHA1SUM(NEWTOY(sha1sum, "b", TOYFLAG_USR|TOYFLAG_BIN))
+USE_MD5SUM(NEWTOY(md5sum, "bj#<1", TOYFLAG_USR|TOYFLAG_BIN))
+USE_SHA1SUM(NEWTOY(sha1sum, "bj#<1", TOYFLAG_USR|TOYFLAG_BIN))
+USE_SHA256SUM(NEWTOY(sha256sum, "bj#<1", TOYFLAG_USR|TOYFLAG_BIN))
+USE_SHA512SUM(NEWTOY(sha512sum, "bj#<1", TOYFLAG_USR|TOYFLAG_BIN))
 
 config MD5SUM
   bool "md5sum"
   default y
   help
-    usage: md5sum [FILE]...
+    usage: md5sum [-b] [-j N] [FILE]...
 
     Calculate md5 hash for each input file, reading from stdin if none.
     Output one hash (16 hex digits) for each input file, followed by
     filename.
 
     -b	brief (hash only, no filename)
+    -j	hash N files at once (output is still in argument order)
 
 config SHA1SUM
   bool "sha1sum"
   default y
   help
-    usage: sha1sum [FILE]...
+    usage: sha1sum [-b] [-j N] [FILE]...
 
     calculate sha1 hash for each input file, reading from stdin if none.
     Output one hash (20 hex digits) for each input file, followed by
     filename.
 
     -b	brief (hash only, no filename)
+    -j	hash N files at once (output is still in argument order)
+
+config SHA256SUM
+  bool "sha256sum"
+  default y
+  help
+    usage: sha256sum [-b] [-j N] [FILE]...
+
+    calculate sha256 hash for each input file, reading from stdin if none.
+    Output one hash (32 hex digits) for each input file, followed by
+    filename.
+
+    -b	brief (hash only, no filename)
+    -j	hash N files at once (output is still in argument order)
+
+config SHA512SUM
+  bool "sha512sum"
+  default y
+  help
+    usage: sha512sum [-b] [-j N] [FILE]...
+
+    calculate sha512 hash for each input file, reading from stdin if none.
+    Output one hash (64 hex digits) for each input file, followed by
+    filename.
+
+    -b	brief (hash only, no filename)
+    -j	hash N files at once (output is still in argument order)
 */
 
 #define FOR_md5sum
 #include "toys.h"
+#if defined(__x86_64__) && defined(__GNUC__)
+#include <cpuid.h>
+#include <immintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO)
+#include <arm_neon.h>
+#endif
 
 GLOBALS(
-  unsigned state[5];
-  unsigned oldstate[5];
-  uint64_t count;
-  union {
-    char c[64];
-    unsigned i[16];
-  } buffer;
+  long j;
+
+  struct hashalg *alg;
+  struct hashjob *jobs;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  long next;
 )
 
+// Per file hash state, so -j threads can each have one.
+struct hashctx {
+  union {
+    unsigned i[8];
+    uint64_t l[8];
+  } state;
+  uint64_t count;
+  char buf[128];
+};
+
+// Transform function hashes whole blocks straight from the input.
+struct hashalg {
+  char *name;
+  int digest, block;
+  void (*transform)(void *state, char *data, long blocks);
+};
+
+struct hashjob {
+  char *out;
+  int done;
+};
+
 #define rol(value, bits) (((value) << (bits)) | ((value) >> (32 - (bits))))
 
 // for(i=0; i<64; i++) md5table[i] = abs(sin(i+1))*(1<<32);  But calculating
@@ -76,173 +135,546 @@ static const uint8_t md5rot[64] = {
   6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
 };
 
-// Mix next 64 bytes of data into md5 hash
+// Mix blocks of 64 bytes of data into md5 hash
 
-static void md5_transform(void)
+static void md5_transform(void *state, char *data, long blocks)
 {
-  unsigned x[4], *b = TT.buffer.i;
+  unsigned x[4], b[16], *st = state;
   int i;
 
-  memcpy(x, TT.state, sizeof(x));
-
-  for (i=0; i<64; i++) {
-    unsigned int in, temp, swap;
-    if (i<16) {
-      in = i;
-      temp = x[1];
-      temp = (temp & x[2]) | ((~temp) & x[3]);
-    } else if (i<32) {
-      in = (1+(5*i))&15;
-      temp = x[3];
-      temp = (x[1] & temp) | (x[2] & ~temp);
-    } else if (i<48) {
-      in = (3*i+5)&15;
-      temp = x[1] ^ x[2] ^ x[3];
-    } else {
-      in = (7*i)&15;
-      temp = x[2] ^ (x[1] | ~x[3]);
+  for (; blocks--; data += 64) {
+    memcpy(b, data, 64);
+    if (IS_BIG_ENDIAN) for (i=0; i<16; i++) b[i] = SWAP_LE32(b[i]);
+    memcpy(x, st, sizeof(x));
+
+    for (i=0; i<64; i++) {
+      unsigned int in, temp, swap;
+      if (i<16) {
+        in = i;
+        temp = x[1];
+        temp = (temp & x[2]) | ((~temp) & x[3]);
+      } else if (i<32) {
+        in = (1+(5*i))&15;
+        temp = x[3];
+        temp = (x[1] & temp) | (x[2] & ~temp);
+      } else if (i<48) {
+        in = (3*i+5)&15;
+        temp = x[1] ^ x[2] ^ x[3];
+      } else {
+        in = (7*i)&15;
+        temp = x[2] ^ (x[1] | ~x[3]);
+      }
+      temp += x[0] + b[in] + md5table[i];
+      swap = x[3];
+      x[3] = x[2];
+      x[2] = x[1];
+      x[1] += rol(temp, md5rot[i]);
+      x[0] = swap;
     }
-    temp += x[0] + b[in] + md5table[i];
-    swap = x[3];
-    x[3] = x[2];
-    x[2] = x[1];
-    x[1] += rol(temp, md5rot[i]);
-    x[0] = swap;
+    for (i=0; i<4; i++) st[i] += x[i];
   }
-  for (i=0; i<4; i++) TT.state[i] += x[i];
 }
 
-// Mix next 64 bytes of data into sha1 hash.
+// Mix blocks of 64 bytes of data into sha1 hash.
 
 static const unsigned rconsts[]={0x5A827999,0x6ED9EBA1,0x8F1BBCDC,0xCA62C1D6};
 
-static void sha1_transform(void)
+static void sha1_transform(void *state, char *data, long blocks)
 {
-  int i, j, k, count;
-  unsigned *block = TT.buffer.i;
-  unsigned *rot[5], *temp;
+  unsigned x[5], w[16], *st = state, work;
+  int i;
 
-  // Copy context->state[] to working vars
-  for (i=0; i<5; i++) {
-    TT.oldstate[i] = TT.state[i];
-    rot[i] = TT.state + i;
+  for (; blocks--; data += 64) {
+    memcpy(w, data, 64);
+    memcpy(x, st, sizeof(x));
+
+    // 4 rounds of 20 operations each, message schedule in a 16 word ring.
+    for (i=0; i<80; i++) {
+      if (i<16) w[i] = SWAP_BE32(w[i]);
+      else w[i&15] = rol(w[(i+13)&15]^w[(i+8)&15]^w[(i+2)&15]^w[i&15], 1);
+      if (i<20) work = (x[1]&x[2])|(~x[1]&x[3]);
+      else if (i>=40 && i<60) work = (x[1]&x[2])|(x[1]&x[3])|(x[2]&x[3]);
+      else work = x[1]^x[2]^x[3];
+      work += rol(x[0], 5) + x[4] + rconsts[i/20] + w[i&15];
+      x[4] = x[3];
+      x[3] = x[2];
+      x[2] = rol(x[1], 30);
+      x[1] = x[0];
+      x[0] = work;
+    }
+    for (i=0; i<5; i++) st[i] += x[i];
   }
-  // 4 rounds of 20 operations each.
-  for (i=count=0; i<4; i++) {
-    for (j=0; j<20; j++) {
-      unsigned work;
+}
+
+// First 32 bits of the fractional parts of the cube roots of the first 64
+// primes (sha512 uses 64 bits of the first 80).
+
+static const unsigned sha256table[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1,
+  0x923f82a4, 0xab1c5ed5, 0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3,
+  0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174, 0xe49b69c1, 0xefbe4786,
+  0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147,
+  0x06ca6351, 0x14292967, 0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13,
+  0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85, 0xa2bfe8a1, 0xa81a664b,
+  0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a,
+  0x5b9cca4f, 0x682e6ff3, 0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208,
+  0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
 
-      work = *rot[2] ^ *rot[3];
-      if (!i) work = (work & *rot[1]) ^ *rot[3];
+static const uint64_t sha512table[80] = {
+  0x428a2f98d728ae22ULL, 0x7137449123ef65cdULL, 0xb5c0fbcfec4d3b2fULL,
+  0xe9b5dba58189dbbcULL, 0x3956c25bf348b538ULL, 0x59f111f1b605d019ULL,
+  0x923f82a4af194f9bULL, 0xab1c5ed5da6d8118ULL, 0xd807aa98a3030242ULL,
+  0x12835b0145706fbeULL, 0x243185be4ee4b28cULL, 0x550c7dc3d5ffb4e2ULL,
+  0x72be5d74f27b896fULL, 0x80deb1fe3b1696b1ULL, 0x9bdc06a725c71235ULL,
+  0xc19bf174cf692694ULL, 0xe49b69c19ef14ad2ULL, 0xefbe4786384f25e3ULL,
+  0x0fc19dc68b8cd5b5ULL, 0x240ca1cc77ac9c65ULL, 0x2de92c6f592b0275ULL,
+  0x4a7484aa6ea6e483ULL, 0x5cb0a9dcbd41fbd4ULL, 0x76f988da831153b5ULL,
+  0x983e5152ee66dfabULL, 0xa831c66d2db43210ULL, 0xb00327c898fb213fULL,
+  0xbf597fc7beef0ee4ULL, 0xc6e00bf33da88fc2ULL, 0xd5a79147930aa725ULL,
+  0x06ca6351e003826fULL, 0x142929670a0e6e70ULL, 0x27b70a8546d22ffcULL,
+  0x2e1b21385c26c926ULL, 0x4d2c6dfc5ac42aedULL, 0x53380d139d95b3dfULL,
+  0x650a73548baf63deULL, 0x766a0abb3c77b2a8ULL, 0x81c2c92e47edaee6ULL,
+  0x92722c851482353bULL, 0xa2bfe8a14cf10364ULL, 0xa81a664bbc423001ULL,
+  0xc24b8b70d0f89791ULL, 0xc76c51a30654be30ULL, 0xd192e819d6ef5218ULL,
+  0xd69906245565a910ULL, 0xf40e35855771202aULL, 0x106aa07032bbd1b8ULL,
+  0x19a4c116b8d2d0c8ULL, 0x1e376c085141ab53ULL, 0x2748774cdf8eeb99ULL,
+  0x34b0bcb5e19b48a8ULL, 0x391c0cb3c5c95a63ULL, 0x4ed8aa4ae3418acbULL,
+  0x5b9cca4f7763e373ULL, 0x682e6ff3d6b2b8a3ULL, 0x748f82ee5defb2fcULL,
+  0x78a5636f43172f60ULL, 0x84c87814a1f0ab72ULL, 0x8cc702081a6439ecULL,
+  0x90befffa23631e28ULL, 0xa4506cebde82bde9ULL, 0xbef9a3f7b2c67915ULL,
+  0xc67178f2e372532bULL, 0xca273eceea26619cULL, 0xd186b8c721c0c207ULL,
+  0xeada7dd6cde0eb1eULL, 0xf57d4f7fee6ed178ULL, 0x06f067aa72176fbaULL,
+  0x0a637dc5a2c898a6ULL, 0x113f9804bef90daeULL, 0x1b710b35131c471bULL,
+  0x28db77f523047d84ULL, 0x32caab7b40c72493ULL, 0x3c9ebe0a15c9bebcULL,
+  0x431d67c49c100d4cULL, 0x4cc5d4becb3e42b6ULL, 0x597f299cfc657e2aULL,
+  0x5fcb6fab3ad6faecULL, 0x6c44198c4a475817ULL
+};
+
+#define ror(value, bits) (((value) >> (bits)) | ((value) << (32 - (bits))))
+#define ror64(value, bits) (((value) >> (bits)) | ((value) << (64 - (bits))))
+
+// Mix blocks of 64 bytes of data into sha256 hash.
+
+static void sha256_transform(void *state, char *data, long blocks)
+{
+  unsigned x[8], w[16], *st = state, t1, t2;
+  int i;
+
+  for (; blocks--; data += 64) {
+    memcpy(w, data, 64);
+    memcpy(x, st, sizeof(x));
+    for (i=0; i<64; i++) {
+      if (i<16) w[i] = SWAP_BE32(w[i]);
       else {
-        if (i==2) work = ((*rot[1]|*rot[2])&*rot[3])|(*rot[1]&*rot[2]);
-        else work ^= *rot[1];
+        t1 = w[(i+1)&15];
+        t2 = w[(i+14)&15];
+        w[i&15] += (ror(t1, 7)^ror(t1, 18)^(t1>>3)) + w[(i+9)&15]
+          + (ror(t2, 17)^ror(t2, 19)^(t2>>10));
       }
+      t1 = x[7] + (ror(x[4], 6)^ror(x[4], 11)^ror(x[4], 25))
+        + ((x[4]&x[5])^(~x[4]&x[6])) + sha256table[i] + w[i&15];
+      t2 = (ror(x[0], 2)^ror(x[0], 13)^ror(x[0], 22))
+        + ((x[0]&x[1])^(x[0]&x[2])^(x[1]&x[2]));
+      memmove(x+1, x, 7*sizeof(*x));
+      x[4] += t1;
+      x[0] = t1+t2;
+    }
+    for (i=0; i<8; i++) st[i] += x[i];
+  }
+}
+
+// Mix blocks of 128 bytes of data into sha512 hash.
+
+static void sha512_transform(void *state, char *data, long blocks)
+{
+  uint64_t x[8], w[16], *st = state, t1, t2;
+  int i;
 
-      if (!i && j<16)
-        work += block[count] = (rol(block[count],24)&0xFF00FF00)
-                             | (rol(block[count],8)&0x00FF00FF);
-      else
-        work += block[count&15] = rol(block[(count+13)&15]
-              ^ block[(count+8)&15] ^ block[(count+2)&15] ^ block[count&15], 1);
-      *rot[4] += work + rol(*rot[0],5) + rconsts[i];
-      *rot[1] = rol(*rot[1],30);
-
-      // Rotate by one for next time.
-      temp = rot[4];
-      for (k=4; k; k--) rot[k] = rot[k-1];
-      *rot = temp;
-      count++;
+  for (; blocks--; data += 128) {
+    memcpy(w, data, 128);
+    memcpy(x, st, sizeof(x));
+    for (i=0; i<80; i++) {
+      if (i<16) w[i] = SWAP_BE64(w[i]);
+      else {
+        t1 = w[(i+1)&15];
+        t2 = w[(i+14)&15];
+        w[i&15] += (ror64(t1, 1)^ror64(t1, 8)^(t1>>7)) + w[(i+9)&15]
+          + (ror64(t2, 19)^ror64(t2, 61)^(t2>>6));
+      }
+      t1 = x[7] + (ror64(x[4], 14)^ror64(x[4], 18)^ror64(x[4], 41))
+        + ((x[4]&x[5])^(~x[4]&x[6])) + sha512table[i] + w[i&15];
+      t2 = (ror64(x[0], 28)^ror64(x[0], 34)^ror64(x[0], 39))
+        + ((x[0]&x[1])^(x[0]&x[2])^(x[1]&x[2]));
+      memmove(x+1, x, 7*sizeof(*x));
+      x[4] += t1;
+      x[0] = t1+t2;
     }
+    for (i=0; i<8; i++) st[i] += x[i];
   }
-  // Add the previous values of state[]
-  for (i=0; i<5; i++) TT.state[i] += TT.oldstate[i];
 }
 
-// Fill the 64-byte working buffer and call transform() when full.
+// Hardware sha1 and sha256: x86 SHA extensions (checked for at runtime),
+// or ARMv8 crypto extensions when the compiler's targeting them.
 
-static void hash_update(char *data, unsigned int len, void (*transform)(void))
+#if defined(__x86_64__) && defined(__GNUC__)
+
+__attribute__((target("sha,sse4.1")))
+static void sha1_hw(void *state, char *data, long blocks)
 {
-  unsigned int i, j;
+  __m128i abcd, e0, e1, prev, sabcd, se0, m[4],
+    mask = _mm_set_epi64x(0x0001020304050607ULL, 0x08090a0b0c0d0e0fULL);
+  unsigned *st = state;
+  int i, j;
+
+  abcd = _mm_shuffle_epi32(_mm_loadu_si128((void *)st), 0x1b);
+  e0 = _mm_set_epi32(st[4], 0, 0, 0);
+  for (; blocks--; data += 64) {
+    sabcd = abcd;
+    se0 = e0;
+    for (i=0; i<4; i++)
+      m[i] = _mm_shuffle_epi8(_mm_loadu_si128((void *)(data+16*i)), mask);
+
+    // 20 groups of 4 rounds. Each group's e comes from the abcd from before
+    // the previous group (sha1nexte rotates it and adds the message words).
+    // Round function is an immediate, so 4 loops of 5 groups.
+#define SHA1_GROUPS(f) for (j = 0; j<5; j++, i++) { \
+      e1 = i ? _mm_sha1nexte_epu32(prev, m[i&3]) : _mm_add_epi32(e0, m[0]); \
+      prev = abcd; \
+      abcd = _mm_sha1rnds4_epu32(abcd, e1, f); \
+      if (i<16) m[i&3] = _mm_sha1msg2_epu32(_mm_xor_si128( \
+        _mm_sha1msg1_epu32(m[i&3], m[(i+1)&3]), m[(i+2)&3]), m[(i+3)&3]); \
+    }
+    prev = abcd;
+    i = 0;
+    SHA1_GROUPS(0) SHA1_GROUPS(1) SHA1_GROUPS(2) SHA1_GROUPS(3)
+#undef SHA1_GROUPS
+    e0 = _mm_sha1nexte_epu32(prev, se0);
+    abcd = _mm_add_epi32(abcd, sabcd);
+  }
+  _mm_storeu_si128((void *)st, _mm_shuffle_epi32(abcd, 0x1b));
+  st[4] = _mm_extract_epi32(e0, 3);
+}
 
-  j = TT.count & 63;
-  TT.count += len;
+__attribute__((target("sha,sse4.1")))
+static void sha256_hw(void *state, char *data, long blocks)
+{
+  __m128i s0, s1, t, msg, ss0, ss1, m[4],
+    mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  unsigned *st = state;
+  int i;
 
-  for (;;) {
-    // Grab next chunk of data, return if it's not enough to process a frame
-    i = 64 - j;
+  // Instructions want state as abef and cdgh.
+  t = _mm_shuffle_epi32(_mm_loadu_si128((void *)st), 0xb1);
+  s1 = _mm_shuffle_epi32(_mm_loadu_si128((void *)(st+4)), 0x1b);
+  s0 = _mm_alignr_epi8(t, s1, 8);
+  s1 = _mm_blend_epi16(s1, t, 0xf0);
+
+  for (; blocks--; data += 64) {
+    ss0 = s0;
+    ss1 = s1;
+    for (i=0; i<4; i++)
+      m[i] = _mm_shuffle_epi8(_mm_loadu_si128((void *)(data+16*i)), mask);
+
+    // 16 groups of 4 rounds, two at a time.
+    for (i=0; i<16; i++) {
+      msg = _mm_add_epi32(m[i&3], _mm_loadu_si128((void *)(sha256table+4*i)));
+      s1 = _mm_sha256rnds2_epu32(s1, s0, msg);
+      s0 = _mm_sha256rnds2_epu32(s0, s1, _mm_shuffle_epi32(msg, 0x0e));
+      if (i<12) m[i&3] = _mm_sha256msg2_epu32(_mm_add_epi32(
+        _mm_sha256msg1_epu32(m[i&3], m[(i+1)&3]),
+        _mm_alignr_epi8(m[(i+3)&3], m[(i+2)&3], 4)), m[(i+3)&3]);
+    }
+    s0 = _mm_add_epi32(s0, ss0);
+    s1 = _mm_add_epi32(s1, ss1);
+  }
+
+  t = _mm_shuffle_epi32(s0, 0x1b);
+  s1 = _mm_shuffle_epi32(s1, 0xb1);
+  _mm_storeu_si128((void *)st, _mm_blend_epi16(t, s1, 0xf0));
+  _mm_storeu_si128((void *)(st+4), _mm_alignr_epi8(s1, t, 8));
+}
+
+static int sha_hw(void)
+{
+  unsigned a, b, c, d;
+
+  return __get_cpuid_count(7, 0, &a, &b, &c, &d) && (b&(1<<29))
+    && __get_cpuid(1, &a, &b, &c, &d) && (c&(1<<19));
+}
+
+#elif defined(__aarch64__) && defined(__ARM_FEATURE_CRYPTO)
+
+static void sha1_hw(void *state, char *data, long blocks)
+{
+  uint32x4_t abcd, sabcd, t, m[4];
+  unsigned *st = state, e0, e1, se0;
+  int i;
+
+  abcd = vld1q_u32(st);
+  e0 = st[4];
+  for (; blocks--; data += 64) {
+    sabcd = abcd;
+    se0 = e0;
+    for (i=0; i<4; i++)
+      m[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8((void *)(data+16*i))));
+
+    // 20 groups of 4 rounds
+    for (i=0; i<20; i++) {
+      t = vaddq_u32(m[i&3], vdupq_n_u32(rconsts[i/5]));
+      e1 = vsha1h_u32(vgetq_lane_u32(abcd, 0));
+      if (i<5) abcd = vsha1cq_u32(abcd, e0, t);
+      else if (i<10 || i>=15) abcd = vsha1pq_u32(abcd, e0, t);
+      else abcd = vsha1mq_u32(abcd, e0, t);
+      e0 = e1;
+      if (i<16) m[i&3] = vsha1su1q_u32(vsha1su0q_u32(m[i&3], m[(i+1)&3],
+        m[(i+2)&3]), m[(i+3)&3]);
+    }
+    abcd = vaddq_u32(abcd, sabcd);
+    e0 += se0;
+  }
+  vst1q_u32(st, abcd);
+  st[4] = e0;
+}
+
+static void sha256_hw(void *state, char *data, long blocks)
+{
+  uint32x4_t s0, s1, ss0, ss1, t, tmp, m[4];
+  unsigned *st = state;
+  int i;
+
+  s0 = vld1q_u32(st);
+  s1 = vld1q_u32(st+4);
+  for (; blocks--; data += 64) {
+    ss0 = s0;
+    ss1 = s1;
+    for (i=0; i<4; i++)
+      m[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8((void *)(data+16*i))));
+
+    // 16 groups of 4 rounds
+    for (i=0; i<16; i++) {
+      t = vaddq_u32(m[i&3], vld1q_u32(sha256table+4*i));
+      tmp = s0;
+      s0 = vsha256hq_u32(s0, s1, t);
+      s1 = vsha256h2q_u32(s1, tmp, t);
+      if (i<12) m[i&3] = vsha256su1q_u32(vsha256su0q_u32(m[i&3], m[(i+1)&3]),
+        m[(i+2)&3], m[(i+3)&3]);
+    }
+    s0 = vaddq_u32(s0, ss0);
+    s1 = vaddq_u32(s1, ss1);
+  }
+  vst1q_u32(st, s0);
+  vst1q_u32(st+4, s1);
+}
+
+static int sha_hw(void)
+{
+  return 1;
+}
+
+#else
+#define sha1_hw sha1_transform
+#define sha256_hw sha256_transform
+
+static int sha_hw(void)
+{
+  return 0;
+}
+#endif
+
+static struct hashalg hashalgs[] = {
+  {"md5sum", 16, 64, md5_transform},
+  {"sha1sum", 20, 64, sha1_transform},
+  {"sha256sum", 32, 64, sha256_transform},
+  {"sha512sum", 64, 128, sha512_transform}
+};
+
+static void hash_init(struct hashctx *ctx)
+{
+  static const unsigned md5sha1[] = {0x67452301, 0xEFCDAB89, 0x98BADCFE,
+      0x10325476, 0xC3D2E1F0},
+    sha256[] = {0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f,
+      0x9b05688c, 0x1f83d9ab, 0x5be0cd19};
+  static const uint64_t sha512[] = {0x6a09e667f3bcc908ULL,
+    0xbb67ae8584caa73bULL, 0x3c6ef372fe94f82bULL, 0xa54ff53a5f1d36f1ULL,
+    0x510e527fade682d1ULL, 0x9b05688c2b3e6c1fULL, 0x1f83d9abfb41bd6bULL,
+    0x5be0cd19137e2179ULL};
+  char *name = TT.alg->name;
+
+  memset(ctx, 0, sizeof(*ctx));
+  if (!strcmp(name, "sha512sum")) memcpy(ctx->state.l, sha512, sizeof(sha512));
+  else if (!strcmp(name, "sha256sum"))
+    memcpy(ctx->state.i, sha256, sizeof(sha256));
+  else memcpy(ctx->state.i, md5sha1, sizeof(md5sha1));
+}
+
+// Hash whole blocks straight from data, copying only partial blocks.
+
+static void hash_update(struct hashctx *ctx, char *data, long len)
+{
+  int bs = TT.alg->block;
+  long i, j = ctx->count & (bs-1);
+
+  ctx->count += len;
+  if (j) {
+    i = bs-j;
     if (i>len) i = len;
-    memcpy(TT.buffer.c+j, data, i);
-    if (j+i != 64) break;
-
-    // Process a frame
-    if (IS_BIG_ENDIAN)
-      for (j=0; j<16; j++) TT.buffer.i[j] = SWAP_LE32(TT.buffer.i[j]);
-    transform();
-    j=0;
+    memcpy(ctx->buf+j, data, i);
+    if (j+i != bs) return;
+    TT.alg->transform(&ctx->state, ctx->buf, 1);
     data += i;
     len -= i;
   }
+  if (len >= bs) TT.alg->transform(&ctx->state, data, len/bs);
+  if (len&(bs-1)) memcpy(ctx->buf, data+(len&~(long)(bs-1)), len&(bs-1));
 }
 
-// Callback for loopfiles()
+// End the message by appending a "1" bit to the data, ending with the
+// message size (in bits, big endian except md5), and adding enough zero bits
+// in between to pad to the end of the next frame. Then write hex digest to
+// out.
 
-static void do_hash(int fd, char *name)
+static void hash_final(struct hashctx *ctx, char *out)
 {
-  uint64_t count;
-  int i, sha1=toys.which->name[0]=='s';;
-  char buf;
-  void (*transform)(void);
-
-  /* SHA1 initialization constants  (md5sum uses first 4) */
-  TT.state[0] = 0x67452301;
-  TT.state[1] = 0xEFCDAB89;
-  TT.state[2] = 0x98BADCFE;
-  TT.state[3] = 0x10325476;
-  TT.state[4] = 0xC3D2E1F0;
-  TT.count = 0;
-
-  transform = sha1 ? sha1_transform : md5_transform;
-  for (;;) {
-    i = read(fd, toybuf, sizeof(toybuf));
-    if (i<1) break;
-    hash_update(toybuf, i, transform);
+  int i, bs = TT.alg->block, md5 = TT.alg->digest == 16;
+  char pad[136] = {0x80};
+  uint64_t count = ctx->count;
+
+  // Pad to length field (8 bytes, or 16 for sha512 which has the high half
+  // of it zero here) at the end of a block.
+  i = bs/8;
+  hash_update(ctx, pad, ((bs-i-1-(count&(bs-1)))&(bs-1))+1+i-8);
+  count <<= 3;
+  count = md5 ? SWAP_LE64(count) : SWAP_BE64(count);
+  hash_update(ctx, (void *)&count, 8);
+
+  for (i = 0; i < TT.alg->digest; i++) {
+    unsigned c;
+
+    if (bs == 128) c = ctx->state.l[i>>3] >> ((7-(i&7))*8);
+    else c = ctx->state.i[i>>2] >> ((md5 ? i&3 : 3-(i&3))*8);
+    out += sprintf(out, "%02x", c&255);
   }
+}
+
+// Callback for loopchunks(), -j threads each have their own hashctx.
+
+static __thread struct hashctx *hash_ctx;
+
+static void hash_chunk(char *data, long len)
+{
+  hash_update(hash_ctx, data, len);
+}
 
-  count = TT.count << 3;
+// Hash one file, returning malloc()ed output line (or NULL if can't open).
 
-  // End the message by appending a "1" bit to the data, ending with the
-  // message size (in bits, big endian), and adding enough zero bits in
-  // between to pad to the end of the next 64-byte frame.
-  //
-  // Since our input up to now has been in whole bytes, we can deal with
-  // bytes here too.
+static char *hash_file(char *name)
+{
+  struct hashctx ctx;
+  char *out = xmalloc(2*64+strlen(name)+4);
+  int fd = strcmp(name, "-") ? open(name, O_RDONLY) : 0;
 
-  buf = 0x80;
-  do {
-    hash_update(&buf, 1, transform);
-    buf = 0;
-  } while ((TT.count & 63) != 56);
-  count = sha1 ? SWAP_BE64(count) : SWAP_LE64(count);
-  hash_update((void *)&count, 8, transform);
+  if (fd == -1) {
+    perror_msg_raw(name);
+    free(out);
 
-  if (sha1)
-    for (i = 0; i < 20; i++)
-      printf("%02x", 255&(TT.state[i>>2] >> ((3-(i & 3)) * 8)));
-  else for (i=0; i<4; i++) printf("%08x", bswap_32(TT.state[i]));
+    return 0;
+  }
+  hash_init(hash_ctx = &ctx);
+  loopchunks(fd, name, hash_chunk);
+  if (fd) close(fd);
+  hash_final(&ctx, out);
 
   // Wipe variables. Cryptographer paranoia.
-  memset(&TT, 0, sizeof(TT));
+  memset(&ctx, 0, sizeof(ctx));
 
-  printf((toys.optflags & FLAG_b) ? "\n" : "  %s\n", name);
+  if (!(toys.optflags & FLAG_b)) strcat(strcat(out, "  "), name);
+
+  return strcat(out, "\n");
+}
+
+static void *hash_worker(void *arg)
+{
+  struct hashjob *job;
+  char *out;
+  long i;
+
+  for (;;) {
+    pthread_mutex_lock(&TT.mutex);
+    i = TT.next++;
+    pthread_mutex_unlock(&TT.mutex);
+    if (i >= toys.optc) break;
+
+    out = hash_file(toys.optargs[i]);
+    job = TT.jobs+i;
+    pthread_mutex_lock(&TT.mutex);
+    job->out = out;
+    job->done = 1;
+    pthread_cond_broadcast(&TT.cond);
+    pthread_mutex_unlock(&TT.mutex);
+  }
+
+  return 0;
 }
 
 void md5sum_main(void)
 {
-  loopfiles(toys.optargs, do_hash);
+  pthread_t *threads;
+  long i, j;
+  char *out;
+
+  for (i = 0; i<ARRAY_LEN(hashalgs); i++)
+    if (!strcmp(toys.which->name, hashalgs[i].name)) TT.alg = hashalgs+i;
+  if (sha_hw()) {
+    if (TT.alg->transform == sha1_transform) TT.alg->transform = sha1_hw;
+    if (TT.alg->transform == sha256_transform) TT.alg->transform = sha256_hw;
+  }
+
+  // Stdin can only be read once, so "-" means one file at a time.
+  for (i = 0; i<toys.optc; i++) if (!strcmp(toys.optargs[i], "-")) TT.j = 1;
+
+  // Workers take files in order, we print results in the same order.
+  if (TT.j>1 && toys.optc>1) {
+    j = TT.j<toys.optc ? TT.j : toys.optc;
+    TT.jobs = xzalloc(toys.optc*sizeof(struct hashjob));
+    threads = xmalloc(j*sizeof(pthread_t));
+    pthread_mutex_init(&TT.mutex, 0);
+    pthread_cond_init(&TT.cond, 0);
+    for (i = 0; i<j; i++) xpthread_create(threads+i, hash_worker, 0);
+    for (i = 0; i<toys.optc; i++) {
+      pthread_mutex_lock(&TT.mutex);
+      while (!TT.jobs[i].done) pthread_cond_wait(&TT.cond, &TT.mutex);
+      pthread_mutex_unlock(&TT.mutex);
+      if (TT.jobs[i].out) xprintf("%s", TT.jobs[i].out);
+      free(TT.jobs[i].out);
+    }
+    for (i = 0; i<j; i++) pthread_join(threads[i], 0);
+    if (CFG_TOYBOX_FREE) {
+      free(threads);
+      free(TT.jobs);
+    }
+  } else if (!toys.optc) {
+    xprintf("%s", out = hash_file("-"));
+    free(out);
+  } else for (i = 0; i<toys.optc; i++) {
+    if ((out = hash_file(toys.optargs[i]))) xprintf("%s", out);
+    free(out);
+  }
 }
 
 void sha1sum_main(void)
 {
   md5sum_main();
 }
+
+void sha256sum_main(void)
+{
+  md5sum_main();
+}
+
+void sha512sum_main(void)
+{
+  md5sum_main();
+}
@@ -1,4 +1,4 @@
-/* bzcat.c - bzip2 decompression
+/* bzcat.c - bzip2 decompression and compression
  *
  * Copyright 2003, 2007 Rob Landley <rob@landley.net>
  *
@@ -13,6 +13,7 @@
 
 USE_BZCAT(NEWTOY(bzcat, NULL, TOYFLAG_USR|TOYFLAG_BIN))
 USE_BUNZIP2(NEWTOY(bunzip2, "cftkv", TOYFLAG_USR|TOYFLAG_BIN))
+USE_BZIP2(NEWTOY(bzip2, "123456789dcftkv[-123456789]", TOYFLAG_USR|TOYFLAG_BIN))
 
 config BUNZIP2
   bool "bunzip2"
@@ -36,12 +37,31 @@ config BZCAT
     usage: bzcat [FILE...]
 
     Decompress listed files to stdout. Use stdin if no files listed.
+
+config BZIP2
+  bool "bzip2"
+  default y
+  help
+    usage: bzip2 [-1-9cdfkt] [FILE...]
+
+    Compress listed files (file becomes file.bz2) deleting original file(s).
+    Read from stdin if no files listed. Blocks are compressed in parallel
+    on multiprocessor systems.
+
+    -1	100k blocks (fastest)
+    -9	900k blocks (best compression, default)
+    -c	force output to stdout
+    -d	decompress (act as bunzip2)
+    -f	force (overwrite existing file.bz2)
+    -k	keep input files (-c implies this)
+    -t	test integrity of compressed files
 */
 
 #define FOR_bunzip2
 #include "toys.h"
 
-#define THREADS 1
+// Most blocks to undo burrows-wheeler on in parallel
+#define THREADS 8
 
 // Constants for huffman coding
 #define MAX_GROUPS               6
@@ -59,6 +79,7 @@ config BZCAT
 #define RETVAL_NOT_BZIP_DATA     (-1)
 #define RETVAL_DATA_ERROR        (-2)
 #define RETVAL_OBSOLETE_INPUT    (-3)
+#define RETVAL_EOF               (-4)
 
 // This is what we know about each huffman coding group
 struct group_data {
@@ -66,29 +87,32 @@ struct group_data {
   char minLen, maxLen;
 };
 
-// Data for burrows wheeler transform
+// Data for burrows wheeler transform, one per block being decoded
 
 struct bwdata {
   unsigned int origPtr;
   int byteCount[256];
-  // State saved when interrupting output
+  // Starting state for undoing the transform
   int writePos, writeRun, writeCount, writeCurrent;
   unsigned int dataCRC, headerCRC;
   unsigned int *dbuf;
+
+  // Decompressed output of this block, and thread producing it
+  struct bunzip_data *bd;
+  char *out;
+  unsigned int outLen, outSize;
+  pthread_t thread;
+  int busy;
 };
 
 // Structure holding all the housekeeping data, including IO buffers and
 // memory that persists between calls to bunzip
 struct bunzip_data {
   // Input stream, input buffer, input bit buffer
-  int in_fd, inbufCount, inbufPos;
+  int in_fd, inbufCount, inbufPos, inbufEOF;
   char *inbuf;
   unsigned int inbufBitCount, inbufBits;
 
-  // Output buffer
-  char outbuf[IOBUF_SIZE];
-  int outbufPos;
-
   unsigned int totalCRC;
 
   // First pass decompression data (Huffman and MTF decoding)
@@ -102,11 +126,13 @@ struct bunzip_data {
 
   // Second pass decompression data (burrows-wheeler transform)
   unsigned int dbufSize;
+  int threads;
   struct bwdata bwdata[THREADS];
 };
 
 // Return the next nnn bits of input.  All reads from the compressed input
-// are done through this function.  All reads are big endian.
+// are done through this function.  All reads are big endian.  Past the end of
+// input this sets inbufEOF and returns zeroes, for the caller to notice.
 static unsigned int get_bits(struct bunzip_data *bd, char bits_wanted)
 {
   unsigned int bits = 0;
@@ -117,8 +143,11 @@ static unsigned int get_bits(struct bunzip_data *bd, char bits_wanted)
 
     // If we need to read more data from file into byte buffer, do so
     if (bd->inbufPos == bd->inbufCount) {
-      if (0 >= (bd->inbufCount = read(bd->in_fd, bd->inbuf, IOBUF_SIZE)))
-        error_exit("input EOF");
+      if (0 >= (bd->inbufCount = read(bd->in_fd, bd->inbuf, IOBUF_SIZE))) {
+        bd->inbufEOF = 1;
+        bd->inbufCount = 1;
+        *bd->inbuf = 0;
+      }
       bd->inbufPos = 0;
     }
 
@@ -349,7 +378,7 @@ static int read_huffman_data(struct bunzip_data *bd, struct bwdata *bw)
     if (!(symCount--)) {
       // Determine which huffman coding group to use.
       symCount = GROUP_SIZE-1;
-      if (selector >= bd->nSelectors) return RETVAL_DATA_ERROR;
+      if (selector >= bd->nSelectors || bd->inbufEOF) return RETVAL_DATA_ERROR;
       hufGroup = bd->groups + bd->selectors[selector++];
       base = hufGroup->base-1;
       limit = hufGroup->limit-1;
@@ -439,25 +468,12 @@ static int read_huffman_data(struct bunzip_data *bd, struct bwdata *bw)
   return 0;
 }
 
-// Flush output buffer to disk
-static void flush_bunzip_outbuf(struct bunzip_data *bd, int out_fd)
-{
-  if (bd->outbufPos) {
-    if (write(out_fd, bd->outbuf, bd->outbufPos) != bd->outbufPos)
-      error_exit("output EOF");
-    bd->outbufPos = 0;
-  }
-}
-
 static void burrows_wheeler_prep(struct bunzip_data *bd, struct bwdata *bw)
 {
   int ii, jj;
   unsigned int *dbuf = bw->dbuf;
   int *byteCount = bw->byteCount;
 
-  // Technically this part is preparation for the burrows-wheeler
-  // transform, but it's quick and convenient to do here.
-
   // Turn byteCount into cumulative occurrence counts of 0 to n-1.
   jj = 0;
   for (ii=0; ii<256; ii++) {
@@ -492,114 +508,78 @@ static void burrows_wheeler_prep(struct bunzip_data *bd, struct bwdata *bw)
   }
 }
 
-// Decompress a block of text to intermediate buffer
-static int read_bunzip_data(struct bunzip_data *bd)
-{
-  int rc = read_block_header(bd, bd->bwdata);
-  if (!rc) rc=read_huffman_data(bd, bd->bwdata);
-
-  // First thing that can be done by a background thread.
-  burrows_wheeler_prep(bd, bd->bwdata);
-
-  return rc;
-}
-
-// Undo burrows-wheeler transform on intermediate buffer to produce output.
-// If !len, write up to len bytes of data to buf.  Otherwise write to out_fd.
-// Returns len ? bytes written : 0.  Notice all errors are negative #'s.
+// Undo burrows-wheeler transform on intermediate buffer to produce output
+// in bw->out. This only touches its own bwdata (and the read-only crc table)
+// so can run in a background thread while the next block's huffman data is
+// read.
 //
 // Burrows-wheeler transform is described at:
 // http://dogma.net/markn/articles/bwt/bwt.htm
 // http://marknelson.us/1996/09/01/bwt/
 
-static int write_bunzip_data(struct bunzip_data *bd, struct bwdata *bw,
-  int out_fd, char *outbuf, int len)
+static void *burrows_wheeler_undo(void *arg)
 {
-  unsigned int *dbuf = bw->dbuf;
-  int count, pos, current, run, copies, outbyte, previous, gotcount = 0;
-
-  for (;;) {
-    // If last read was short due to end of file, return last block now
-    if (bw->writeCount < 0) return bw->writeCount;
-
-    // If we need to refill dbuf, do it.
-    if (!bw->writeCount) {
-      int i = read_bunzip_data(bd);
-      if (i) {
-        if (i == RETVAL_LAST_BLOCK) {
-          bw->writeCount = i;
-          return gotcount;
-        } else return i;
-      }
+  struct bwdata *bw = arg;
+  unsigned int *dbuf = bw->dbuf, *crc32Table = bw->bd->crc32Table, crc;
+  int count, pos, current, run, copies, outbyte, previous;
+
+  burrows_wheeler_prep(bw->bd, bw);
+
+  count = bw->writeCount;
+  pos = bw->writePos;
+  current = bw->writeCurrent;
+  run = bw->writeRun;
+  crc = bw->dataCRC;
+  bw->outLen = 0;
+  while (count) {
+    count--;
+
+    // Follow sequence vector to undo Burrows-Wheeler transform.
+    previous = current;
+    pos = dbuf[pos];
+    current = pos&0xff;
+    pos >>= 8;
+
+    // Whenever we see 3 consecutive copies of the same byte,
+    // the 4th is a repeat count
+    if (run++ == 3) {
+      copies = current;
+      outbyte = previous;
+      current = -1;
+    } else {
+      copies = 1;
+      outbyte = current;
     }
 
-    // loop generating output
-    count = bw->writeCount;
-    pos = bw->writePos;
-    current = bw->writeCurrent;
-    run = bw->writeRun;
-    while (count) {
-
-      // If somebody (like tar) wants a certain number of bytes of
-      // data from memory instead of written to a file, humor them.
-      if (len && bd->outbufPos >= len) goto dataus_interruptus;
-      count--;
-
-      // Follow sequence vector to undo Burrows-Wheeler transform.
-      previous = current;
-      pos = dbuf[pos];
-      current = pos&0xff;
-      pos >>= 8;
-
-      // Whenever we see 3 consecutive copies of the same byte,
-      // the 4th is a repeat count
-      if (run++ == 3) {
-        copies = current;
-        outbyte = previous;
-        current = -1;
-      } else {
-        copies = 1;
-        outbyte = current;
-      }
-
-      // Output bytes to buffer, flushing to file if necessary
-      while (copies--) {
-        if (bd->outbufPos == IOBUF_SIZE) flush_bunzip_outbuf(bd, out_fd);
-        bd->outbuf[bd->outbufPos++] = outbyte;
-        bw->dataCRC = (bw->dataCRC << 8)
-                ^ bd->crc32Table[(bw->dataCRC >> 24) ^ outbyte];
-      }
-      if (current != previous) run=0;
+    // Output bytes to buffer, expanding it if a run won't fit
+    if (bw->outSize-bw->outLen < 256)
+      bw->out = xrealloc(bw->out, bw->outSize *= 2);
+    while (copies--) {
+      bw->out[bw->outLen++] = outbyte;
+      crc = (crc << 8) ^ crc32Table[(crc >> 24) ^ outbyte];
     }
+    if (current != previous) run=0;
+  }
+  bw->dataCRC = ~crc;
 
-    // decompression of this block completed successfully
-    bw->dataCRC = ~(bw->dataCRC);
-    bd->totalCRC = ((bd->totalCRC << 1) | (bd->totalCRC >> 31)) ^ bw->dataCRC;
+  return 0;
+}
 
-    // if this block had a crc error, force file level crc error.
-    if (bw->dataCRC != bw->headerCRC) {
-      bd->totalCRC = bw->headerCRC+1;
+// Wait for a block's output, then check its crc and write it to out_fd.
+// With out_fd -1 just wait for it (so we can free memory after an error).
+static int write_bunzip_data(struct bunzip_data *bd, struct bwdata *bw,
+  int out_fd)
+{
+  if (bd->threads>1) pthread_join(bw->thread, 0);
+  bw->busy = 0;
+  if (out_fd == -1) return 0;
 
-      return RETVAL_LAST_BLOCK;
-    }
-dataus_interruptus:
-    bw->writeCount = count;
-    if (len) {
-      gotcount += bd->outbufPos;
-      memcpy(outbuf, bd->outbuf, len);
-
-      // If we got enough data, checkpoint loop state and return
-      if ((len -= bd->outbufPos)<1) {
-        bd->outbufPos -= len;
-        if (bd->outbufPos) memmove(bd->outbuf, bd->outbuf+len, bd->outbufPos);
-        bw->writePos = pos;
-        bw->writeCurrent = current;
-        bw->writeRun = run;
-
-        return gotcount;
-      }
-    }
-  }
+  // if this block had a crc error, force file level crc error.
+  if (bw->dataCRC != bw->headerCRC) return RETVAL_DATA_ERROR;
+  bd->totalCRC = ((bd->totalCRC << 1) | (bd->totalCRC >> 31)) ^ bw->dataCRC;
+  xwrite(out_fd, bw->out, bw->outLen);
+
+  return 0;
 }
 
 // Allocate the structure, read file header. If !len, src_fd contains
@@ -628,15 +608,26 @@ static int start_bunzip(struct bunzip_data **bdp, int src_fd, char *inbuf,
   crc_init(bd->crc32Table, 0);
 
   // Ensure that file starts with "BZh".
-  for (i=0;i<3;i++) if (get_bits(bd,8)!="BZh"[i]) return RETVAL_NOT_BZIP_DATA;
+  for (i=0;i<3;i++) if (get_bits(bd,8)!="BZh"[i]) break;
 
   // Next byte ascii '1'-'9', indicates block size in units of 100k of
   // uncompressed data. Allocate intermediate buffer for block.
-  i = get_bits(bd, 8);
+  if (i==3) i = get_bits(bd, 8);
+  if (bd->inbufEOF) return RETVAL_EOF;
   if (i<'1' || i>'9') return RETVAL_NOT_BZIP_DATA;
-  bd->dbufSize = 100000*(i-'0')*THREADS;
-  for (i=0; i<THREADS; i++)
-    bd->bwdata[i].dbuf = xmalloc(bd->dbufSize * sizeof(int));
+  bd->dbufSize = 100000*(i-'0');
+
+  // Decode blocks in parallel if we have the processors for it.
+  bd->threads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (bd->threads<2) bd->threads = 1;
+  else if (++bd->threads>THREADS) bd->threads = THREADS;
+  for (i=0; i<bd->threads; i++) {
+    struct bwdata *bw = bd->bwdata+i;
+
+    bw->bd = bd;
+    bw->dbuf = xmalloc(bd->dbufSize * sizeof(int));
+    bw->out = xmalloc(bw->outSize = bd->dbufSize);
+  }
 
   return 0;
 }
@@ -646,16 +637,44 @@ static int start_bunzip(struct bunzip_data **bdp, int src_fd, char *inbuf,
 static char *bunzipStream(int src_fd, int dst_fd)
 {
   struct bunzip_data *bd;
-  char *bunzip_errors[] = {0, "not bzip", "bad data", "old format"};
-  int i, j;
+  char *bunzip_errors[] = {0, "not bzip", "bad data", "old format",
+    "input EOF"};
+  struct bwdata *bw;
+  unsigned crc = 0;
+  int i, j, rc, k = 0;
 
   if (!(i = start_bunzip(&bd,src_fd, 0, 0))) {
-    i = write_bunzip_data(bd,bd->bwdata, dst_fd, 0, 0);
-    if (i==RETVAL_LAST_BLOCK && bd->bwdata[0].headerCRC==bd->totalCRC) i = 0;
+    // Read each block's huffman data here (the bitstream is serial), then
+    // undo its burrows-wheeler transform in the background while we read
+    // the next. Output is written in block order when a slot is reused.
+    for (;;) {
+      bw = bd->bwdata+(k++%bd->threads);
+      if (bw->busy && (i = write_bunzip_data(bd, bw, dst_fd))) break;
+      // Truncated input is reported after writing the blocks we finished.
+      if (!(i = read_block_header(bd, bw))) i = read_huffman_data(bd, bw);
+      if (bd->inbufEOF) i = RETVAL_EOF;
+      if (i) break;
+      bw->busy++;
+      if (bd->threads>1) xpthread_create(&bw->thread, burrows_wheeler_undo, bw);
+      else burrows_wheeler_undo(bw);
+    }
+    crc = bw->headerCRC;
+
+    // Write out remaining blocks in order (or just wait for them on error).
+    for (j=0; j<bd->threads; j++) {
+      bw = bd->bwdata+(k++%bd->threads);
+      if (!bw->busy) continue;
+      rc = write_bunzip_data(bd, bw,
+        (i==RETVAL_LAST_BLOCK || i==RETVAL_EOF) ? dst_fd : -1);
+      if (rc) i = rc;
+    }
+    if (i==RETVAL_LAST_BLOCK) i = crc==bd->totalCRC ? 0 : RETVAL_DATA_ERROR;
   }
-  flush_bunzip_outbuf(bd, dst_fd);
 
-  for (j=0; j<THREADS; j++) free(bd->bwdata[j].dbuf);
+  for (j=0; j<bd->threads; j++) {
+    free(bd->bwdata[j].dbuf);
+    free(bd->bwdata[j].out);
+  }
   free(bd);
 
   return bunzip_errors[-i];
@@ -676,24 +695,31 @@ void bzcat_main(void)
 static void do_bunzip2(int fd, char *name)
 {
   int outfd = 1, rename = 0, len = strlen(name);
-  char *tmp, *err, *dotbz = 0;
+  char *tmp, *err, *dotbz;
 
   // Trim off .bz or .bz2 extension
   dotbz = name+len-3;
-  if ((len>3 && !strcmp(dotbz, ".bz")) || (len>4 && !strcmp(--dotbz, ".bz2")))
+  if ((len<4 || strcmp(dotbz, ".bz")) && (len<5 || strcmp(--dotbz, ".bz2")))
     dotbz = 0;
 
   // For - no replace
   if (toys.optflags&FLAG_t) outfd = xopen("/dev/null", O_WRONLY);
   else if ((fd || strcmp(name, "-")) && !(toys.optflags&FLAG_c)) {
-    if (toys.optflags&FLAG_k) {
-      if (!dotbz || !access(name, X_OK)) {
-        error_msg("%s exists", name);
+    // Without an extension to remove, -f replaces the original.
+    if (!dotbz && (toys.optflags&(FLAG_k|FLAG_f)) != FLAG_f) {
+      error_msg("%s: no .bz extension", name);
 
-        return;
-      }
+      return;
+    }
+    if (dotbz) *dotbz = 0;
+    if (dotbz && !(toys.optflags&FLAG_f) && !access(name, F_OK)) {
+      error_msg("%s exists", name);
+      *dotbz = '.';
+
+      return;
     }
     outfd = copy_tempfile(fd, name, &tmp);
+    if (dotbz) *dotbz = '.';
     rename++;
   }
 
@@ -706,13 +732,8 @@ static void do_bunzip2(int fd, char *name)
 
   // can't test outfd==1 because may have been called with stdin+stdout closed
   if (rename) {
-    if (toys.optflags&FLAG_k) {
-      free(tmp);
-      tmp = 0;
-    } else {
-      if (dotbz) *dotbz = '.';
-      if (!unlink(name)) perror_msg_raw(name);
-    }
+    if (!err && dotbz && !(toys.optflags&FLAG_k) && unlink(name))
+      perror_msg_raw(name);
     (err ? delete_tempfile : replace_tempfile)(-1, outfd, &tmp);
   }
 }
@@ -721,3 +742,412 @@ void bunzip2_main(void)
 {
   loopfiles(toys.optargs, do_bunzip2);
 }
+
+// Compression: the main thread run length encodes input into blocks (so it
+// knows where each block ends), then burrows-wheeler, move to front, and
+// huffman coding of each block happen in a background thread writing to its
+// own bit buffer, which the main thread splices into the output in order
+// (blocks aren't byte aligned).
+
+#define CLEANUP_bunzip2
+#define FOR_bzip2
+#include "generated/flags.h"
+
+// Big endian bit output, to fd (or with fd -1, growing in memory)
+struct bzbits {
+  int fd, count;
+  unsigned long long bits;
+  char *out;
+  long len, size;
+};
+
+// One block being compressed
+struct bzblock {
+  struct bzip_data *bz;
+  unsigned char *block;
+  int len, *sort;
+  unsigned int crc;
+  struct bzbits bits;
+  pthread_t thread;
+  int busy;
+};
+
+struct bzip_data {
+  // Input stream, input buffer, and pending run of identical bytes
+  int in_fd, inbufCount, inbufPos, runChar, runLen;
+  unsigned char inbuf[IOBUF_SIZE];
+
+  struct bzbits out;
+  unsigned int crc32Table[256], totalCRC;
+  int level, max, threads;
+  struct bzblock blocks[THREADS];
+};
+
+static void put_bits(struct bzbits *bb, unsigned int val, int bits)
+{
+  bb->bits = (bb->bits<<bits)|val;
+  bb->count += bits;
+  while (bb->count >= 8) {
+    if (bb->len == bb->size) {
+      if (bb->fd == -1) bb->out = xrealloc(bb->out, bb->size *= 2);
+      else {
+        xwrite(bb->fd, bb->out, bb->len);
+        bb->len = 0;
+      }
+    }
+    bb->out[bb->len++] = bb->bits>>(bb->count -= 8);
+  }
+}
+
+// Append pending run to block: up to 3 copies as-is, else 4 plus a count.
+static void bzip2_run(struct bzip_data *bz, struct bzblock *bb)
+{
+  int i;
+
+  for (i = 0; i<bz->runLen && i<4; i++) bb->block[bb->len++] = bz->runChar;
+  if (bz->runLen>3) bb->block[bb->len++] = bz->runLen-4;
+  bz->runLen = 0;
+}
+
+// Read input into block until it's full, collapsing runs of 4 to 255
+// identical bytes. Calculates block's crc. Returns 0 at end of input.
+static int bzip2_fill(struct bzip_data *bz, struct bzblock *bb)
+{
+  unsigned int crc = 0xffffffff;
+  unsigned char c;
+
+  bb->len = 0;
+  while (bb->len < bz->max) {
+    if (bz->inbufPos == bz->inbufCount) {
+      if (0 > (bz->inbufCount = read(bz->in_fd, bz->inbuf, IOBUF_SIZE)))
+        perror_exit("read");
+      bz->inbufPos = 0;
+      if (!bz->inbufCount) break;
+    }
+    c = bz->inbuf[bz->inbufPos++];
+    crc = (crc << 8) ^ bz->crc32Table[(crc >> 24) ^ c];
+    if (bz->runLen && (c != bz->runChar || bz->runLen == 255))
+      bzip2_run(bz, bb);
+    bz->runChar = c;
+    bz->runLen++;
+  }
+  if (bz->runLen) bzip2_run(bz, bb);
+  bb->crc = ~crc;
+
+  return bb->len;
+}
+
+// Sort the rotations of block by prefix doubling: sort by first character,
+// then repeatedly sort by (rank of first h bytes, rank of next h bytes) with
+// a counting sort until all ranks are unique. Result is in ptr.
+static void bzip2_sort(unsigned char *block, int len, int *ptr, int *work)
+{
+  int *rank = work, *newptr = work+len, *newrank = work+2*len,
+      *count = work+3*len, *swap, i, h, ranks;
+
+  memset(count, 0, 256*sizeof(int));
+  for (i = 0; i<len; i++) count[block[i]]++;
+  for (i = 1; i<256; i++) count[i] += count[i-1];
+  for (i = len; i--;) ptr[--count[block[i]]] = i;
+  for (rank[ptr[0]] = 0, ranks = i = 1; i<len; i++) {
+    if (block[ptr[i]] != block[ptr[i-1]]) ranks++;
+    rank[ptr[i]] = ranks-1;
+  }
+
+  for (h = 1; h<len && ranks<len; h <<= 1) {
+    // Already sorted by second half, so stable sort by first half.
+    for (i = 0; i<len; i++) if ((newptr[i] = ptr[i]-h) < 0) newptr[i] += len;
+    memset(count, 0, ranks*sizeof(int));
+    for (i = 0; i<len; i++) count[rank[newptr[i]]]++;
+    for (i = 1; i<ranks; i++) count[i] += count[i-1];
+    for (i = len; i--;) ptr[--count[rank[newptr[i]]]] = newptr[i];
+
+    for (newrank[ptr[0]] = 0, ranks = i = 1; i<len; i++) {
+      int a = ptr[i]+h, b = ptr[i-1]+h;
+
+      if (a >= len) a -= len;
+      if (b >= len) b -= len;
+      if (rank[ptr[i]] != rank[ptr[i-1]] || rank[a] != rank[b]) ranks++;
+      newrank[ptr[i]] = ranks-1;
+    }
+    swap = rank;
+    rank = newrank;
+    newrank = swap;
+  }
+}
+
+// Calculate huffman code lengths for freq[] no longer than 17 bits, treating
+// 0 as 1 so every symbol gets a code. Halve weights until lengths fit.
+static void bzip2_lengths(unsigned char *length, int *freq, int symCount)
+{
+  int weight[2*MAX_SYMBOLS], parent[2*MAX_SYMBOLS], ii, jj, aa, bb, max;
+
+  for (ii = 0; ii<symCount; ii++) weight[ii] = freq[ii] ? freq[ii] : 1;
+  for (;;) {
+    // Repeatedly merge two lightest nodes without a parent.
+    for (ii = 0; ii<symCount; ii++) parent[ii] = -1;
+    for (jj = symCount; jj<2*symCount-1; jj++) {
+      for (aa = bb = -1, ii = 0; ii<jj; ii++) {
+        if (parent[ii] != -1) continue;
+        if (aa == -1 || weight[ii] < weight[aa]) {
+          bb = aa;
+          aa = ii;
+        } else if (bb == -1 || weight[ii] < weight[bb]) bb = ii;
+      }
+      weight[jj] = weight[aa]+weight[bb];
+      parent[aa] = parent[bb] = jj;
+      parent[jj] = -1;
+    }
+
+    // Code length is depth in tree
+    for (max = ii = 0; ii<symCount; ii++) {
+      for (jj = 0, aa = ii; parent[aa] != -1; aa = parent[aa]) jj++;
+      if ((length[ii] = jj) > max) max = jj;
+    }
+    if (max <= 17) return;
+    for (ii = 0; ii<symCount; ii++) weight[ii] = 1+weight[ii]/2;
+  }
+}
+
+// Compress one block into bb->bits. Runs in a background thread, touching
+// only its own bzblock and the read-only crc table.
+static void *bzip2_block(void *arg)
+{
+  struct bzblock *bb = arg;
+  struct bzbits *out = &bb->bits;
+  int len = bb->len, *ptr = bb->sort, origPtr = 0, symTotal = 0, nSyms = 0,
+    groupCount, nSelectors, ii, jj, kk, tt, zero, freq[MAX_SYMBOLS],
+    tfreq[MAX_GROUPS][MAX_SYMBOLS], code[MAX_GROUPS][MAX_SYMBOLS];
+  unsigned short *syms = (void *)(bb->sort+len);
+  unsigned char byteToSym[256], mtfSymbol[256], *block = bb->block,
+    length[MAX_GROUPS][MAX_SYMBOLS], *selectors = (void *)(bb->sort+3*len);
+  char inUse[256];
+
+  bzip2_sort(block, len, ptr, bb->sort+len);
+
+  // Which byte values are used, mapped to consecutive symbols
+  memset(inUse, 0, 256);
+  for (ii = 0; ii<len; ii++) inUse[block[ii]] = 1;
+  for (ii = 0; ii<256; ii++) if (inUse[ii]) byteToSym[ii] = symTotal++;
+
+  // Move to front encode last column of sorted rotations, turning runs of
+  // zeroes into RUNA/RUNB bijective base 2 counts. Literals are position+1.
+  memset(freq, 0, sizeof(freq));
+  for (ii = 0; ii<symTotal; ii++) mtfSymbol[ii] = ii;
+  for (ii = zero = 0; ii<=len; ii++) {
+    unsigned char uc = 0;
+
+    if (ii<len) {
+      if (!(jj = ptr[ii])) origPtr = ii;
+      uc = byteToSym[block[jj ? jj-1 : len-1]];
+      if (mtfSymbol[0] == uc) {
+        zero++;
+        continue;
+      }
+    }
+    if (zero) {
+      for (zero--;; zero = (zero-2)/2) {
+        freq[syms[nSyms++] = zero&1]++;
+        if (zero<2) break;
+      }
+      zero = 0;
+    }
+    if (ii == len) break;
+    for (jj = 0; mtfSymbol[jj] != uc; jj++);
+    memmove(mtfSymbol+1, mtfSymbol, jj);
+    mtfSymbol[0] = uc;
+    freq[syms[nSyms++] = jj+1]++;
+  }
+  freq[syms[nSyms++] = symTotal+1]++;
+  symTotal += 2;
+
+  // Start with each table favoring a contiguous range of symbols, then
+  // refine: pick the cheapest table for every group of GROUP_SIZE symbols,
+  // and rebuild each table from the symbols it got.
+  groupCount = nSyms<200 ? 2 : nSyms<600 ? 3 : nSyms<1200 ? 4
+    : nSyms<2400 ? 5 : 6;
+  for (tt = groupCount, ii = 0, kk = nSyms; tt; tt--) {
+    int target = kk/tt, sum = 0;
+
+    for (jj = ii; jj<symTotal && (sum<target || jj == ii); jj++)
+      sum += freq[jj];
+    for (zero = 0; zero<symTotal; zero++)
+      length[tt-1][zero] = (zero>=ii && zero<jj) ? 0 : 15;
+    ii = jj;
+    kk -= sum;
+  }
+  nSelectors = (nSyms+GROUP_SIZE-1)/GROUP_SIZE;
+  for (kk = 0; kk<4; kk++) {
+    memset(tfreq, 0, sizeof(tfreq));
+    for (ii = 0; ii<nSelectors; ii++) {
+      int cost[MAX_GROUPS], best = 0, end = (ii+1)*GROUP_SIZE;
+
+      if (end > nSyms) end = nSyms;
+      for (tt = 0; tt<groupCount; tt++) {
+        for (cost[tt] = 0, jj = ii*GROUP_SIZE; jj<end; jj++)
+          cost[tt] += length[tt][syms[jj]];
+        if (cost[tt] < cost[best]) best = tt;
+      }
+      selectors[ii] = best;
+      for (jj = ii*GROUP_SIZE; jj<end; jj++) tfreq[best][syms[jj]]++;
+    }
+    for (tt = 0; tt<groupCount; tt++)
+      bzip2_lengths(length[tt], tfreq[tt], symTotal);
+  }
+
+  // Canonical codes: shorter first, same length in symbol order.
+  for (tt = 0; tt<groupCount; tt++)
+    for (ii = kk = 0; ii<=20; ii++, kk <<= 1)
+      for (jj = 0; jj<symTotal; jj++)
+        if (length[tt][jj] == ii) code[tt][jj] = kk++;
+
+  // Block header, see read_block_header()
+  out->len = out->count = 0;
+  put_bits(out, 0x314159, 24);
+  put_bits(out, 0x265359, 24);
+  put_bits(out, bb->crc, 32);
+  put_bits(out, 0, 1);
+  put_bits(out, origPtr, 24);
+  for (ii = kk = 0; ii<16; ii++)
+    for (jj = 0; jj<16; jj++) if (inUse[16*ii+jj]) kk |= 1<<(15-ii);
+  put_bits(out, kk, 16);
+  for (ii = 0; ii<16; ii++) {
+    if (!(kk & (1<<(15-ii)))) continue;
+    for (tt = jj = 0; jj<16; jj++) if (inUse[16*ii+jj]) tt |= 1<<(15-jj);
+    put_bits(out, tt, 16);
+  }
+  put_bits(out, groupCount, 3);
+  put_bits(out, nSelectors, 15);
+  for (ii = 0; ii<groupCount; ii++) mtfSymbol[ii] = ii;
+  for (ii = 0; ii<nSelectors; ii++) {
+    for (jj = 0; mtfSymbol[jj] != selectors[ii]; jj++) put_bits(out, 1, 1);
+    put_bits(out, 0, 1);
+    memmove(mtfSymbol+1, mtfSymbol, jj);
+    mtfSymbol[0] = selectors[ii];
+  }
+
+  // Code lengths as deltas: 10 is +1, 11 is -1, 0 is next symbol
+  for (tt = 0; tt<groupCount; tt++) {
+    put_bits(out, kk = length[tt][0], 5);
+    for (ii = 0; ii<symTotal; ii++) {
+      for (; kk<length[tt][ii]; kk++) put_bits(out, 2, 2);
+      for (; kk>length[tt][ii]; kk--) put_bits(out, 3, 2);
+      put_bits(out, 0, 1);
+    }
+  }
+
+  // Huffman coded symbols, switching tables every GROUP_SIZE
+  for (ii = 0; ii<nSyms; ii++) {
+    tt = selectors[ii/GROUP_SIZE];
+    put_bits(out, code[tt][syms[ii]], length[tt][syms[ii]]);
+  }
+
+  return 0;
+}
+
+// Wait for block, add it to the stream crc, and splice its bits into output.
+static void bzip2_write(struct bzip_data *bz, struct bzblock *bb)
+{
+  long ii;
+
+  if (bz->threads>1) pthread_join(bb->thread, 0);
+  bb->busy = 0;
+  bz->totalCRC = ((bz->totalCRC << 1) | (bz->totalCRC >> 31)) ^ bb->crc;
+  for (ii = 0; ii<bb->bits.len; ii++)
+    put_bits(&bz->out, (unsigned char)bb->bits.out[ii], 8);
+  put_bits(&bz->out, bb->bits.bits&((1<<bb->bits.count)-1), bb->bits.count);
+}
+
+static void bzipStream(int src_fd, int dst_fd, int level)
+{
+  struct bzip_data *bz = xzalloc(sizeof(struct bzip_data));
+  struct bzblock *bb;
+  int i, k = 0;
+
+  bz->in_fd = src_fd;
+  bz->out.fd = dst_fd;
+  bz->out.out = xmalloc(bz->out.size = 65536);
+  crc_init(bz->crc32Table, 0);
+
+  // Leave room for a final run, and keep the decoder's origPtr check happy.
+  bz->max = 100000*level-19;
+  bz->threads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (bz->threads<1) bz->threads = 1;
+  if (bz->threads>THREADS) bz->threads = THREADS;
+
+  put_bits(&bz->out, 'B', 8);
+  put_bits(&bz->out, 'Z', 8);
+  put_bits(&bz->out, 'h', 8);
+  put_bits(&bz->out, '0'+level, 8);
+
+  // Fill each slot on the main thread, compress in background (if we have
+  // more than one processor), write out in order as slots come back around.
+  for (;;) {
+    bb = bz->blocks+(k%bz->threads);
+    if (bb->busy) bzip2_write(bz, bb);
+    if (!bb->block) {
+      bb->bz = bz;
+      bb->block = xmalloc(bz->max+5);
+      bb->sort = xmalloc((5*bz->max+256)*sizeof(int));
+      bb->bits.fd = -1;
+      bb->bits.out = xmalloc(bb->bits.size = bz->max);
+    }
+    if (!bzip2_fill(bz, bb)) break;
+    bb->busy++;
+    k++;
+    if (bz->threads>1) xpthread_create(&bb->thread, bzip2_block, bb);
+    else bzip2_block(bb);
+  }
+  for (i = 0; i<bz->threads; i++) {
+    bb = bz->blocks+(k++%bz->threads);
+    if (bb->busy) bzip2_write(bz, bb);
+  }
+
+  // End of stream marker (sqrt(pi)) and combined crc, then pad to byte.
+  put_bits(&bz->out, 0x177245, 24);
+  put_bits(&bz->out, 0x385090, 24);
+  put_bits(&bz->out, bz->totalCRC, 32);
+  if (bz->out.count) put_bits(&bz->out, 0, 8-bz->out.count);
+  xwrite(dst_fd, bz->out.out, bz->out.len);
+
+  for (i = 0; i<bz->threads; i++) {
+    free(bz->blocks[i].block);
+    free(bz->blocks[i].sort);
+    free(bz->blocks[i].bits.out);
+  }
+  free(bz->out.out);
+  free(bz);
+}
+
+static void do_bzip2(int fd, char *name)
+{
+  int outfd = 1, level, i;
+  char *outname = 0;
+  struct stat st;
+
+  // Last -1 through -9 wins, default 9
+  for (level = 9, i = 1; i<10; i++)
+    if (toys.optflags & (FLAG_1>>(i-1))) level = i;
+
+  if ((fd || strcmp(name, "-")) && !(toys.optflags&FLAG_c)) {
+    outname = xmprintf("%s.bz2", name);
+    if (fstat(fd, &st)) st.st_mode = 0644;
+    outfd = xcreate(outname,
+      O_WRONLY|O_CREAT|O_TRUNC|(O_EXCL*!(toys.optflags&FLAG_f)),
+      st.st_mode&07777);
+  }
+
+  bzipStream(fd, outfd, level);
+
+  if (outname) {
+    xclose(outfd);
+    if (!(toys.optflags&FLAG_k) && unlink(name)) perror_msg_raw(name);
+    free(outname);
+  }
+}
+
+void bzip2_main(void)
+{
+  if (toys.optflags&(FLAG_d|FLAG_t)) bunzip2_main();
+  else loopfiles(toys.optargs, do_bzip2);
+}
@@ -17,22 +17,23 @@ config REV
 
 static void do_rev(int fd, char *name)
 {
+  struct linebuf *lb = linebuf_new(fd);
   char *c;
 
   for (;;) {
-    int len, i;
+    long len, i;
 
-    if (!(c = get_line(fd))) break;
-    len = strlen(c) - 1;
-    for (i = 0; i <= len/2; i++) {
+    if (!(c = linebuf_view(lb, &len, '\n'))) break;
+    if (c[len-1] == '\n') c[--len] = 0;
+    for (i = 0; i < len/2; i++) {
       char tmp = c[i];
 
-      c[i] = c[len-i];
-      c[len-i] = tmp;
+      c[i] = c[len-1-i];
+      c[len-1-i] = tmp;
     }
     xputs(c);
-    free(c);
   }
+  linebuf_free(lb);
 }
 
 void rev_main(void)
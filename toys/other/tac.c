@@ -17,6 +17,7 @@ config TAC
 
 static void do_tac(int fd, char *name)
 {
+  struct linebuf *lb = linebuf_new(fd);
   struct arg_list *list = NULL;
   char *c;
 
@@ -25,13 +26,14 @@ static void do_tac(int fd, char *name)
     struct arg_list *temp;
     long len;
 
-    if (!(c = get_rawline(fd, &len, '\n'))) break;
+    if (!(c = linebuf_line(lb, &len, '\n'))) break;
 
     temp = xmalloc(sizeof(struct arg_list));
     temp->next = list;
     temp->arg = c;
     list = temp;
   }
+  linebuf_free(lb);
 
   // Play them back.
   while (list) {
@@ -16,7 +16,7 @@
 // Leave Lrg at end so flag values line up.
 
 USE_COMPRESS(NEWTOY(compress, "zcd9lrg[-cd][!zgLr]", TOYFLAG_USR|TOYFLAG_BIN))
-USE_GZIP(NEWTOY(gzip, USE_GZIP_D("d")"19dcflqStvgLRz[!gLRz]", TOYFLAG_USR|TOYFLAG_BIN))
+USE_GZIP(NEWTOY(gzip, USE_GZIP_D("d")"123456789cflp#<1qStvgLRz[-123456789][!gLRz]", TOYFLAG_USR|TOYFLAG_BIN))
 USE_ZCAT(NEWTOY(zcat, 0, TOYFLAG_USR|TOYFLAG_BIN))
 USE_GUNZIP(NEWTOY(gunzip, "cflqStv", TOYFLAG_USR|TOYFLAG_BIN))
 
@@ -42,7 +42,7 @@ config GZIP
   default y
   depends on COMPRESS
   help
-    usage: gzip [-19cfqStvzgLR] [FILE...]
+    usage: gzip [-1-9cfqStvzgLR] [-p N] [FILE...]
 
     Compess (deflate) file(s). With no files, compress stdin to stdout.
 
@@ -51,9 +51,10 @@ config GZIP
     a new file without the .gz extension (with same ownership/permissions).
 
     -1	Minimal compression (fastest)
-    -9	Max compression (default)
+    -9	Max compression (default is -6)
     -c	cat to stdout (act as zcat)
     -f	force (if output file exists, input is tty, unrecognized extension)
+    -p	compress using N threads (default 1)
     -q	quiet (no warnings)
     -S	specify exension (default .*)
     -t	test compressed file(s)
@@ -117,28 +118,48 @@ config GUNZIP
 #define FOR_compress
 #include "toys.h"
 
+// Inflate output buffer (32k history plus 256k), and huffman decode table
+// sizes: literal root table is 10 bits, distance root table 8 bits.
+#define INFLATE_OUT (32768+262144)
+#define LITHUFF ((1<<10)+288*(1<<5))
+#define DISTHUFF ((1<<8)+30*(1<<7))
+
 GLOBALS(
+  long threads;
+
   // Huffman codes: base offset and extra bits tables (length and distance)
   char lenbits[29], distbits[30];
   unsigned short lenbase[29], distbase[30];
-  void *fixdisthuff, *fixlithuff;
+  unsigned *fixdisthuff, *fixlithuff, *disthuff, *lithuff, *clhuff;
 
   // CRC
   void (*crcfunc)(char *data, int len);
-  unsigned crc;
+  unsigned crc, crc_table[8*256];
 
   // Compressed data buffer
   char *data;
-  unsigned pos, len;
+  unsigned pos, len, flushed;
   int infd, outfd;
 
   // Tables only used for deflation
-  unsigned short *hashhead, *hashchain;
+  void *ds;
+  int level;
+  char lencode[256], distcode[512];
+
+  // Block parallel compression: job ring and its lock
+  void *jobs;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  long submitted, taken;
 )
 
-// little endian bit buffer
+// little endian bit buffer. Reading keeps up to 64 bits of input in bits,
+// writing to fd -1 collects output in out/outlen.
 struct bitbuf {
-  int fd, bitpos, len, max;
+  int fd, bitpos, len, max, pos, bitcnt, eof;
+  unsigned long long bits;
+  char *out;
+  long outlen;
   char buf[];
 };
 
@@ -153,61 +174,74 @@ struct bitbuf *bitbuf_init(int fd, int size)
   return bb;
 }
 
-// Advance bitpos without the overhead of recording bits
-void bitbuf_skip(struct bitbuf *bb, int bits)
+// Top up bits to at least 56 (unless we hit end of input), 8 bytes at a time
+// when the buffer has that many. Bits above bitcnt may hold a copy of the
+// upcoming input bytes, so anything reading buf directly must zero bits.
+static void bitbuf_refill(struct bitbuf *bb)
 {
-  int pos = bb->bitpos + bits, len = bb->len << 3;
+  while (bb->bitcnt < 56) {
+    if (bb->pos == bb->len) {
+      if (bb->eof) return;
+      bb->pos = 0;
+      if (1>(bb->len = read(bb->fd, bb->buf, bb->max))) {
+        bb->len = 0;
+        bb->eof++;
+        return;
+      }
+    }
+    if (bb->pos+8 <= bb->len) {
+      unsigned long long ll;
 
-  while (pos >= len) {
-    pos -= len;
-    len = (bb->len = read(bb->fd, bb->buf, bb->max)) << 3;
-    if (bb->len < 1) perror_exit("inflate EOF");
+      memcpy(&ll, bb->buf+bb->pos, 8);
+      bb->bits |= SWAP_LE64(ll) << bb->bitcnt;
+      bb->pos += (63-bb->bitcnt)>>3;
+      bb->bitcnt |= 56;
+    } else {
+      bb->bits |= (unsigned long long)(unsigned char)bb->buf[bb->pos++]
+        << bb->bitcnt;
+      bb->bitcnt += 8;
+    }
   }
-  bb->bitpos = pos;
 }
 
-// Optimized single bit inlined version
-static inline int bitbuf_bit(struct bitbuf *bb)
+// Fetch the next X bits (at most 32) from the bitbuf, little endian
+static unsigned bitbuf_get(struct bitbuf *bb, int bits)
 {
-  int bufpos = bb->bitpos>>3;
+  unsigned result;
 
-  if (bufpos == bb->len) {
-    bitbuf_skip(bb, 0);
-    bufpos = 0;
+  if (bb->bitcnt < bits) {
+    bitbuf_refill(bb);
+    if (bb->bitcnt < bits) error_exit("inflate EOF");
   }
+  result = bb->bits & ((1ULL<<bits)-1);
+  bb->bits >>= bits;
+  bb->bitcnt -= bits;
 
-  return (bb->buf[bufpos]>>(bb->bitpos++&7))&1;
+  return result;
 }
 
-// Fetch the next X bits from the bitbuf, little endian
-unsigned bitbuf_get(struct bitbuf *bb, int bits)
+// Discard bits from input
+static void bitbuf_skip(struct bitbuf *bb, int bits)
 {
-  int result = 0, offset = 0;
-
   while (bits) {
-    int click = bb->bitpos >> 3, blow, blen;
-
-    // Load more data if buffer empty
-    if (click == bb->len) bitbuf_skip(bb, click = 0);
+    int n = bits>32 ? 32 : bits;
 
-    // grab bits from next byte
-    blow = bb->bitpos & 7;
-    blen = 8-blow;
-    if (blen > bits) blen = bits;
-    result |= ((bb->buf[click] >> blow) & ((1<<blen)-1)) << offset;
-    offset += blen;
-    bits -= blen;
-    bb->bitpos += blen;
+    bitbuf_get(bb, n);
+    bits -= n;
   }
-
-  return result;
 }
 
 void bitbuf_flush(struct bitbuf *bb)
 {
+  int len = (bb->bitpos+7)/8;
+
   if (!bb->bitpos) return;
 
-  xwrite(bb->fd, bb->buf, (bb->bitpos+7)/8);
+  if (bb->fd == -1) {
+    bb->out = xrealloc(bb->out, bb->outlen+len);
+    memcpy(bb->out+bb->outlen, bb->buf, len);
+    bb->outlen += len;
+  } else xwrite(bb->fd, bb->buf, len);
   memset(bb->buf, 0, bb->max);
   bb->bitpos = 0;
 }
@@ -232,72 +266,100 @@ void bitbuf_put(struct bitbuf *bb, int data, int len)
   }
 }
 
-static void output_byte(char sym)
+// Write out decoded data, then keep the last 32k as history for matches.
+static void inflate_flush(void)
 {
-  int pos = TT.pos++ & 32767;
-
-  TT.data[pos] = sym;
-
-  if (!pos) {
-    xwrite(TT.outfd, TT.data, 32768);
-    if (TT.crcfunc) TT.crcfunc(TT.data, 32768);
+  xwrite(TT.outfd, TT.data+TT.flushed, TT.pos-TT.flushed);
+  if (TT.crcfunc) TT.crcfunc(TT.data+TT.flushed, TT.pos-TT.flushed);
+  if (TT.pos > 32768) {
+    memmove(TT.data, TT.data+TT.pos-32768, 32768);
+    TT.pos = 32768;
   }
+  TT.flushed = TT.pos;
 }
 
 // Huffman coding uses bits to traverse a binary tree to a leaf node,
 // By placing frequently occurring symbols at shorter paths, frequently
 // used symbols may be represented in fewer bits than uncommon symbols.
 
-struct huff {
-  unsigned short length[16];
-  unsigned short symbol[288];
-};
+// Rather than walk the tree a bit at a time, we decode with a lookup table
+// indexed by the next "root" bits of input. Each entry is either a symbol
+// (symbol<<16 | code length) or, for codes longer than root bits, a link to
+// a second level table (offset<<16 | 256 | bits indexing it). Zero entries
+// are unused codes. Subtables of at most 2^(15-root) entries follow the root
+// table, one per root prefix, so there's room for at most 288 of them.
 
-// Create simple huffman tree from array of bit lengths.
+// Create decoding table from array of bit lengths.
 
 // The symbols in the huffman trees are sorted (first by bit length
 // of the code to reach them, then by symbol number). This means that given
 // the bit length of each symbol, we can construct a unique tree.
-static void len2huff(struct huff *huff, char bitlen[], int len)
+static void len2huff(unsigned *huff, char bitlen[], int len, int root)
 {
-  int offset[16];
-  int i;
-
-  // Count number of codes at each bit length
-  memset(huff, 0, sizeof(struct huff));
-  for (i = 0; i<len; i++) huff->length[bitlen[i]]++;
-
-  // Sort symbols by bit length. (They'll remain sorted by symbol within that.)
-  *huff->length = *offset = 0;
-  for (i = 1; i<16; i++) offset[i] = offset[i-1] + huff->length[i-1];
+  unsigned short count[16], next[16], sub[1024], rev[288];
+  int i, j, k, code, left, off = 1<<root, mask = off-1;
+
+  // Count number of codes at each bit length, reject oversubscribed trees
+  memset(count, 0, sizeof(count));
+  for (i = 0; i<len; i++) count[bitlen[i]]++;
+  for (count[0] = 0, left = 1, i = 1; i<16; i++)
+    if ((left = (left<<1)-count[i]) < 0) error_exit("bad tree");
+  for (code = 0, i = 1; i<16; i++) next[i] = code = (code+count[i-1])<<1;
+
+  // Assign codes (bit reversed since deflate sends them starting from the
+  // most significant bit), and find width of each second level table
+  memset(sub, 0, sizeof(short)<<root);
+  for (i = 0; i<len; i++) if ((j = bitlen[i])) {
+    for (code = next[j]++, rev[i] = 0; j--; code >>= 1)
+      rev[i] = (rev[i]<<1)|(code&1);
+    if (bitlen[i]-root > sub[rev[i]&mask]) sub[rev[i]&mask] = bitlen[i]-root;
+  }
+  memset(huff, 0, sizeof(unsigned)<<root);
+  for (i = 0; i<=mask; i++) if (sub[i]) {
+    huff[i] = (off<<16)|256|sub[i];
+    memset(huff+off, 0, sizeof(unsigned)<<sub[i]);
+    off += 1<<sub[i];
+  }
 
-  for (i = 0; i<len; i++) if (bitlen[i]) huff->symbol[offset[bitlen[i]]++] = i;
+  // Fill in every entry whose low bits match each code
+  for (i = 0; i<len; i++) if ((j = bitlen[i])) {
+    unsigned *t = huff;
+
+    code = rev[i];
+    k = root;
+    if (j > root) {
+      t += huff[code&mask]>>16;
+      k = huff[code&mask]&15;
+      code >>= root;
+      j -= root;
+    }
+    for (; code < 1<<k; code += 1<<j) t[code] = (i<<16)|bitlen[i];
+  }
 }
 
 // Fetch and decode next huffman coded symbol from bitbuf.
-// This takes advantage of the sorting to navigate the tree as an array:
-// each time we fetch a bit we have all the codes at that bit level in
-// order with no gaps.
-static unsigned huff_and_puff(struct bitbuf *bb, struct huff *huff)
+static unsigned huff_and_puff(struct bitbuf *bb, unsigned *huff, int root)
 {
-  unsigned short *length = huff->length;
-  int start = 0, offset = 0;
+  unsigned e;
 
-  // Traverse through the bit lengths until our code is in this range
-  for (;;) {
-    offset = (offset << 1) | bitbuf_bit(bb);
-    start += *++length;
-    if ((offset -= *length) < 0) break;
-    if ((length - huff->length) & 16) error_exit("bad symbol");
-  }
+  if (bb->bitcnt < 15) bitbuf_refill(bb);
+  e = huff[bb->bits&((1<<root)-1)];
+  if (e&256) e = huff[(e>>16)+((bb->bits>>root)&((1<<(e&15))-1))];
+  if (!(e&15) || (e&15) > bb->bitcnt) error_exit("bad symbol");
+  bb->bits >>= e&15;
+  bb->bitcnt -= e&15;
 
-  return huff->symbol[start + offset];
+  return e>>16;
 }
 
 // Decompress deflated data from bitbuf to TT.outfd.
 static void inflate(struct bitbuf *bb)
 {
+  char *out = TT.data;
+
   TT.crc = ~0;
+  TT.len = TT.pos = TT.flushed = 0;
+
   // repeat until spanked
   for (;;) {
     int final, type;
@@ -312,34 +374,43 @@ static void inflate(struct bitbuf *bb)
       int len, nlen;
 
       // Align to byte, read length
-      bitbuf_skip(bb, (8-bb->bitpos)&7);
+      bitbuf_skip(bb, bb->bitcnt&7);
       len = bitbuf_get(bb, 16);
       nlen = bitbuf_get(bb, 16);
       if (len != (0xffff & ~nlen)) error_exit("bad len");
 
-      // Dump literal output data
+      // Dump literal output data: whole bytes already loaded into bits first,
+      // then straight from the input buffer.
       while (len) {
-        int pos = bb->bitpos >> 3, bblen = bb->len - pos;
-        char *p = bb->buf+pos;
-
-        // dump bytes until done or end of current bitbuf contents
-        if (bblen > len) bblen = len;
-        pos = bblen;
-        while (pos--) output_byte(*(p++));
-        bitbuf_skip(bb, bblen << 3);
-        len -= bblen;
+        int n = INFLATE_OUT-TT.pos;
+
+        if (!n) inflate_flush();
+        else if (bb->bitcnt) {
+          out[TT.pos++] = bitbuf_get(bb, 8);
+          len--;
+        } else if (bb->pos == bb->len) {
+          bitbuf_refill(bb);
+          if (!bb->bitcnt) error_exit("inflate EOF");
+        } else {
+          if (n > len) n = len;
+          if (n > bb->len-bb->pos) n = bb->len-bb->pos;
+          memcpy(out+TT.pos, bb->buf+bb->pos, n);
+          bb->bits = 0;
+          bb->pos += n;
+          TT.pos += n;
+          len -= n;
+        }
       }
 
     // Compressed block
     } else {
-      struct huff *disthuff, *lithuff;
+      unsigned *disthuff, *lithuff;
 
       // Dynamic huffman codes?
       if (type == 2) {
-        struct huff *h2 = ((struct huff *)toybuf)+1;
         int i, litlen, distlen, hufflen;
         char *hufflen_order = "\x10\x11\x12\0\x08\x07\x09\x06\x0a\x05\x0b"
-                              "\x04\x0c\x03\x0d\x02\x0e\x01\x0f", *bits;
+                              "\x04\x0c\x03\x0d\x02\x0e\x01\x0f", bits[320];
 
         // The huffman trees are stored as a series of bit lengths
         litlen = bitbuf_get(bb, 5)+257;  // max 288
@@ -350,13 +421,13 @@ static void inflate(struct bitbuf *bb)
         // a complicated way: an array of bit lengths (hufflen many
         // entries, each 3 bits) is used to fill out an array of 19 entries
         // in a magic order, leaving the rest 0. Then make a tree out of it:
-        memset(bits = toybuf+1, 0, 19);
+        memset(bits, 0, 19);
         for (i=0; i<hufflen; i++) bits[hufflen_order[i]] = bitbuf_get(bb, 3);
-        len2huff(h2, bits, 19);
+        len2huff(TT.clhuff, bits, 19, 7);
 
         // Use that tree to read in the literal and distance bit lengths
         for (i = 0; i < litlen + distlen;) {
-          int sym = huff_and_puff(bb, h2);
+          int sym = huff_and_puff(bb, TT.clhuff, 7);
 
           // 0-15 are literals, 16 = repeat previous code 3-6 times,
           // 17 = 3-10 zeroes (3 bit), 18 = 11-138 zeroes (7 bit)
@@ -364,15 +435,16 @@ static void inflate(struct bitbuf *bb)
           else {
             int len = sym & 2;
 
+            if (sym == 16 && !i) error_exit("bad tree");
             len = bitbuf_get(bb, sym-14+len+(len>>1)) + 3 + (len<<2);
-            memset(bits+i, bits[i-1] * !(sym&3), len);
+            if (i+len > litlen+distlen) error_exit("bad tree");
+            memset(bits+i, sym == 16 ? bits[i-1] : 0, len);
             i += len;
           }
         }
-        if (i > litlen+distlen) error_exit("bad tree");
 
-        len2huff(lithuff = h2, bits, litlen);
-        len2huff(disthuff = ((struct huff *)toybuf)+2, bits+litlen, distlen);
+        len2huff(lithuff = TT.lithuff, bits, litlen, 10);
+        len2huff(disthuff = TT.disthuff, bits+litlen, distlen, 8);
 
       // Static huffman codes
       } else {
@@ -380,24 +452,43 @@ static void inflate(struct bitbuf *bb)
         disthuff = TT.fixdisthuff;
       }
 
-      // Use huffman tables to decode block of compressed symbols
+      // Use huffman tables to decode block of compressed symbols. A symbol
+      // needs at most 48 bits of input and produces at most 258 bytes.
       for (;;) {
-        int sym = huff_and_puff(bb, lithuff);
+        int sym;
+
+        if (TT.pos > INFLATE_OUT-258) inflate_flush();
+        if (bb->bitcnt < 48) bitbuf_refill(bb);
+        sym = huff_and_puff(bb, lithuff, 10);
 
         // Literal?
-        if (sym < 256) output_byte(sym);
+        if (sym < 256) out[TT.pos++] = sym;
 
         // Copy range?
         else if (sym > 256) {
-          int len, dist;
+          unsigned len, dist;
+          char *to, *from;
 
-          sym -= 257;
+          if ((sym -= 257) > 28) error_exit("bad symbol");
           len = TT.lenbase[sym] + bitbuf_get(bb, TT.lenbits[sym]);
-          sym = huff_and_puff(bb, disthuff);
+          if ((sym = huff_and_puff(bb, disthuff, 8)) > 29)
+            error_exit("bad symbol");
           dist = TT.distbase[sym] + bitbuf_get(bb, TT.distbits[sym]);
-          sym = TT.pos & 32767;
-
-          while (len--) output_byte(TT.data[(TT.pos-dist) & 32767]);
+          if (dist > TT.pos) error_exit("bad distance");
+
+          // Overlapping copies repeat the last dist bytes, so copy from the
+          // same start doubling the length each time.
+          from = (to = out+TT.pos)-dist;
+          TT.pos += len;
+          if (dist >= len) memcpy(to, from, len);
+          else if (dist == 1) memset(to, *from, len);
+          else while (len) {
+            if (dist > len) dist = len;
+            memcpy(to, from, dist);
+            to += dist;
+            len -= dist;
+            dist += dist;
+          }
 
         // End of block
         } else break;
@@ -408,61 +499,473 @@ static void inflate(struct bitbuf *bb)
     if (final) break;
   }
 
-  if (TT.pos & 32767) {
-    xwrite(TT.outfd, TT.data, TT.pos & 32767);
-    if (TT.crcfunc) TT.crcfunc(TT.data, TT.pos & 32767);
+  inflate_flush();
+}
+
+// Deflate state: the window holds 64k of input (the 32k we can match against
+// plus 32k of lookahead), head has the most recent window position of each
+// 3 byte hash and prev links each position to the previous one with the same
+// hash. Matches and literals are buffered in lc/dist until we emit a block.
+// Input comes from infd, or from in/inlen if that's set.
+
+#define WSIZE 32768
+#define MIN_LOOKAHEAD (258+3+1)
+#define MAX_DIST (WSIZE-MIN_LOOKAHEAD)
+#define SYMBUF 16384
+
+struct deflate {
+  int infd, level, good, lazy, nice, chain, eof, syms;
+  unsigned char *in;
+  unsigned inlen;
+  unsigned strstart, lookahead, match_start, match_length, prev_length;
+  long block_start;
+  unsigned char *window;
+  unsigned short *head, *prev, *lc, *dist;
+  unsigned litfreq[286], distfreq[30];
+  char fixbits[288+30];
+  unsigned short fixcodes[288+30];
+};
+
+// good, lazy, nice, chain for compression levels 1-9 (same tuning as zlib).
+// Levels 1-3 are greedy, and lazy is the longest match to hash all of.
+static unsigned short deflate_levels[][4] = {
+  {4, 4, 8, 4}, {4, 5, 16, 8}, {4, 6, 32, 32}, {4, 4, 16, 16}, {8, 16, 32, 32},
+  {8, 16, 128, 128}, {8, 32, 128, 256}, {32, 128, 258, 1024},
+  {32, 258, 258, 4096}
+};
+
+static int uintcmp(const void *a, const void *b)
+{
+  unsigned aa = *(unsigned *)a, bb = *(unsigned *)b;
+
+  return (aa > bb) - (aa < bb);
+}
+
+// Calculate huffman code lengths (at most max bits) from symbol frequencies.
+static void freq2len(unsigned *freq, char *bitlen, int len, int max)
+{
+  unsigned sym[288], weight[576], count[16], total = 0;
+  unsigned short parent[576], depth[576];
+  int i, n = 0, leaf, node, next;
+
+  memset(bitlen, 0, len);
+  memset(count, 0, sizeof(count));
+
+  // Sort used symbols by frequency. A valid tree needs at least two codes.
+  for (i = 0; i<len; i++) if (freq[i]) sym[n++] = (freq[i]<<9)|i;
+  for (i = 0; n<2; i++) if (!freq[i]) sym[n++] = (1<<9)|i;
+  qsort(sym, n, sizeof(unsigned), uintcmp);
+  for (i = 0; i<n; i++) weight[i] = sym[i]>>9;
+
+  // Leaves are sorted and internal nodes are created in increasing weight
+  // order, so the two lightest nodes are always at the head of one queue.
+  for (leaf = 0, node = next = n; next < 2*n-1; next++) {
+    int j, pick;
+
+    weight[next] = 0;
+    for (j = 0; j<2; j++) {
+      if (leaf<n && (node==next || weight[leaf]<=weight[node])) pick = leaf++;
+      else pick = node++;
+      weight[next] += weight[pick];
+      parent[pick] = next;
+    }
   }
+  depth[2*n-2] = 0;
+  for (i = 2*n-3; i>=0; i--) depth[i] = depth[parent[i]]+1;
+
+  // Clamp lengths to max, then lengthen short codes until the tree fits.
+  for (i = 0; i<n; i++) count[depth[i]>max ? max : depth[i]]++;
+  for (i = max; i; i--) total += count[i]<<(max-i);
+  while (total > 1<<max) {
+    count[max]--;
+    for (i = max-1; i; i--) if (count[i]) {
+      count[i]--;
+      count[i+1] += 2;
+      break;
+    }
+    total--;
+  }
+
+  // Most frequent symbols get the shortest codes.
+  for (i = 1, leaf = n; i<=max; i++)
+    while (count[i]) count[i]--, bitlen[sym[--leaf]&511] = i;
 }
 
-// Deflate from TT.infd to bitbuf
-// For deflate, TT.len = input read, TT.pos = input consumed
-static void deflate(struct bitbuf *bb)
+// Assign canonical huffman codes to an array of bit lengths. Deflate sends
+// huffman codes starting from the most significant bit, so reverse them.
+static void len2code(char *bitlen, unsigned short *code, int len)
 {
-  char *data = TT.data;
-  int len, final = 0;
+  unsigned short count[16], next[16];
+  int i, j, c = 0;
+
+  memset(count, 0, sizeof(count));
+  for (i = 0; i<len; i++) count[bitlen[i]]++;
+  for (count[0] = 0, i = 1; i<16; i++) next[i] = c = (c+count[i-1])<<1;
+  for (i = 0; i<len; i++) {
+    c = next[bitlen[i]]++;
+    for (code[i] = j = 0; j<bitlen[i]; j++) code[i] = (code[i]<<1)|((c>>j)&1);
+  }
+}
 
-  TT.crc = ~0;
+static int dist_code(unsigned dist)
+{
+  return TT.distcode[dist<256 ? dist : 256+(dist>>7)];
+}
 
-  while (!final) {
-    // Read next half-window of data if we haven't hit EOF yet.
-    len = readall(TT.infd, data+(TT.len&32768), 32768);
-    if (len < 0) perror_exit("read"); // todo: add filename
-    if (len != 32768) final++;
-    if (TT.crcfunc) TT.crcfunc(data+(TT.len&32768), len);
-    // TT.len += len;  crcfunc advances len
+// Write buffered symbols with the given literal/length and distance codes
+static void deflate_syms(struct deflate *ds, struct bitbuf *bb, char *litbits,
+  unsigned short *litcodes, char *distbits, unsigned short *distcodes)
+{
+  int i, c;
+
+  for (i = 0; i<ds->syms; i++) {
+    unsigned lc = ds->lc[i], dist = ds->dist[i];
+
+    if (!dist) bitbuf_put(bb, litcodes[lc], litbits[lc]);
+    else {
+      c = TT.lencode[lc-3];
+      bitbuf_put(bb, litcodes[c+257], litbits[c+257]);
+      bitbuf_put(bb, lc-TT.lenbase[c], TT.lenbits[c]);
+      c = dist_code(dist-1);
+      bitbuf_put(bb, distcodes[c], distbits[c]);
+      bitbuf_put(bb, dist-TT.distbase[c], TT.distbits[c]);
+    }
+  }
+  bitbuf_put(bb, litcodes[256], litbits[256]);
+}
 
-    // store block as literal
+// Emit buffered symbols as whichever of a dynamic huffman, static huffman,
+// or stored block is smallest.
+static void deflate_block(struct deflate *ds, struct bitbuf *bb, int final)
+{
+  char bits[286+30], clbits[19], cl[286+30], clx[286+30],
+    *hufflen_order = "\x10\x11\x12\0\x08\x07\x09\x06\x0a\x05\x0b"
+                     "\x04\x0c\x03\x0d\x02\x0e\x01\x0f",
+    *litbits = bits, *distbits = bits+286;
+  unsigned short codes[286+30], clcodes[19];
+  unsigned clfreq[19], len = ds->strstart-ds->block_start;
+  int i, j, n, c, hlit, hdist, hclen;
+  long long extra = 0, dyn, fix, stored = LLONG_MAX;
+
+  ds->litfreq[256]++;
+  freq2len(ds->litfreq, litbits, 286, 15);
+  freq2len(ds->distfreq, distbits, 30, 15);
+  for (hlit = 286; hlit>257 && !litbits[hlit-1]; hlit--);
+  for (hdist = 30; hdist>1 && !distbits[hdist-1]; hdist--);
+  if (hlit != 286) memmove(litbits+hlit, distbits, hdist);
+
+  // The code lengths are themselves run length encoded and huffman coded:
+  // 16 = repeat previous length 3-6 times, 17 = 3-10 zeroes, 18 = 11-138 zeroes
+  memset(clfreq, 0, sizeof(clfreq));
+  for (i = n = 0; i<hlit+hdist; i += j) {
+    c = bits[i];
+    for (j = 1; i+j<hlit+hdist && bits[i+j]==c && j<138; j++);
+    if (!c && j>=3) {
+      cl[n] = j<11 ? 17 : 18;
+      clx[n] = j-(j<11 ? 3 : 11);
+    } else if (c && j>=4) {
+      clx[n] = 0;
+      clfreq[cl[n++] = c]++;
+      if (j>7) j = 7;
+      cl[n] = 16;
+      clx[n] = j-4;
+    } else {
+      cl[n] = c;
+      clx[n] = 0;
+      j = 1;
+    }
+    clfreq[cl[n++]]++;
+  }
+  freq2len(clfreq, clbits, 19, 7);
+  for (hclen = 19; hclen>4 && !clbits[hufflen_order[hclen-1]]; hclen--);
+
+  // Size of each block type in bits
+  for (i = 0; i<29; i++) extra += ds->litfreq[257+i]*TT.lenbits[i];
+  for (i = 0; i<30; i++) extra += ds->distfreq[i]*TT.distbits[i];
+  dyn = 17+3*hclen+extra;
+  for (i = 0; i<19; i++)
+    dyn += clfreq[i]*(clbits[i]+(i>15 ? "\2\3\7"[i-16] : 0));
+  for (i = 0; i<hlit; i++) dyn += ds->litfreq[i]*bits[i];
+  for (i = 0; i<hdist; i++) dyn += ds->distfreq[i]*bits[hlit+i];
+  fix = 3+extra;
+  for (i = 0; i<286; i++) fix += ds->litfreq[i]*ds->fixbits[i];
+  for (i = 0; i<30; i++) fix += ds->distfreq[i]*5;
+  // Stored blocks need the block's data still in the window.
+  if (ds->block_start>=0) stored = (len+5*(len/65535+1))*8LL+7;
+
+  if (stored<dyn && stored<fix) {
+    char *p = (char *)ds->window+ds->block_start;
+
+    do {
+      n = len>65535 ? 65535 : len;
+      len -= n;
+      bitbuf_put(bb, final && !len, 1);
+      bitbuf_put(bb, 0, 2);
+      bitbuf_put(bb, 0, (8-bb->bitpos)&7);
+      bitbuf_put(bb, n, 16);
+      bitbuf_put(bb, 0xffff&~n, 16);
+      while (n--) bitbuf_put(bb, *p++, 8);
+    } while (len);
+  } else if (fix<=dyn) {
+    bitbuf_put(bb, final, 1);
+    bitbuf_put(bb, 1, 2);
+    deflate_syms(ds, bb, ds->fixbits, ds->fixcodes, ds->fixbits+288,
+      ds->fixcodes+288);
+  } else {
     bitbuf_put(bb, final, 1);
-    bitbuf_put(bb, 0, 1);
+    bitbuf_put(bb, 2, 2);
+    bitbuf_put(bb, hlit-257, 5);
+    bitbuf_put(bb, hdist-1, 5);
+    bitbuf_put(bb, hclen-4, 4);
+    for (i = 0; i<hclen; i++) bitbuf_put(bb, clbits[hufflen_order[i]], 3);
+    len2code(clbits, clcodes, 19);
+    for (i = 0; i<n; i++) {
+      bitbuf_put(bb, clcodes[cl[i]], clbits[cl[i]]);
+      if (cl[i]>15) bitbuf_put(bb, clx[i], "\2\3\7"[cl[i]-16]);
+    }
+    len2code(litbits, codes, hlit);
+    len2code(distbits = bits+hlit, codes+hlit, hdist);
+    deflate_syms(ds, bb, litbits, codes, distbits, codes+hlit);
+  }
 
-    bitbuf_put(bb, 0, (8-bb->bitpos)&7);
-    bitbuf_put(bb, len, 16);
-    bitbuf_put(bb, 0xffff & ~len, 16);
+  memset(ds->litfreq, 0, sizeof(ds->litfreq));
+  memset(ds->distfreq, 0, sizeof(ds->distfreq));
+  ds->syms = 0;
+  ds->block_start = ds->strstart;
+}
 
-    // repeat until spanked
-    while (TT.pos != TT.len) {
-      unsigned pos = TT.pos & 65535;
+// Buffer a literal (dist 0) or a match of length lc at distance dist.
+// Returns true when the buffer is full and it's time to emit a block.
+static int deflate_sym(struct deflate *ds, unsigned dist, unsigned lc)
+{
+  ds->lc[ds->syms] = lc;
+  ds->dist[ds->syms] = dist;
+  if (!dist) ds->litfreq[lc]++;
+  else {
+    ds->litfreq[TT.lencode[lc-3]+257]++;
+    ds->distfreq[dist_code(dist-1)]++;
+  }
 
-      bitbuf_put(bb, data[pos], 8);
+  return ++ds->syms == SYMBUF;
+}
 
-      // need to refill buffer?
-      if (!(32767 & ++TT.pos) && !final) break;
+// Read more input into the window, sliding it down 32k if it's full.
+static void fill_window(struct deflate *ds)
+{
+  unsigned i, more;
+  int len;
+
+  if (ds->strstart >= WSIZE+MAX_DIST) {
+    memcpy(ds->window, ds->window+WSIZE, WSIZE);
+    ds->match_start -= WSIZE;
+    ds->strstart -= WSIZE;
+    ds->block_start -= WSIZE;
+    for (i = 0; i<WSIZE; i++) {
+      ds->head[i] = ds->head[i]>=WSIZE ? ds->head[i]-WSIZE : 0;
+      ds->prev[i] = ds->prev[i]>=WSIZE ? ds->prev[i]-WSIZE : 0;
     }
   }
+  if (ds->eof) return;
+  more = 2*WSIZE-ds->strstart-ds->lookahead;
+  if (ds->in) {
+    len = ds->inlen<more ? ds->inlen : more;
+    memcpy(ds->window+ds->strstart+ds->lookahead, ds->in, len);
+    ds->in += len;
+    ds->inlen -= len;
+  } else {
+    len = readall(ds->infd, ds->window+ds->strstart+ds->lookahead, more);
+    if (len < 0) perror_exit("read"); // todo: add filename
+    if (TT.crcfunc)
+      TT.crcfunc((char *)ds->window+ds->strstart+ds->lookahead, len);
+  }
+  if (len != more) ds->eof++;
+  ds->lookahead += len;
+}
+
+// Add position to hash chain, returning previous position with same hash.
+static unsigned insert_hash(struct deflate *ds, unsigned pos)
+{
+  unsigned char *p = ds->window+pos;
+  unsigned old, h = ((p[0]|(p[1]<<8)|(p[2]<<16))*2654435761U)>>17;
+
+  old = ds->head[h];
+  ds->prev[pos&(WSIZE-1)] = old;
+  ds->head[h] = pos;
+
+  return old;
+}
+
+// Walk the hash chain looking for a longer match than prev_length.
+static unsigned longest_match(struct deflate *ds, unsigned cur)
+{
+  unsigned char *scan = ds->window+ds->strstart, *match;
+  unsigned chain = ds->chain, best = ds->prev_length, nice = ds->nice,
+    limit = ds->strstart>MAX_DIST ? ds->strstart-MAX_DIST : 0,
+    max = ds->lookahead<258 ? ds->lookahead : 258, len;
+
+  if (best >= ds->good) chain >>= 2;
+  if (nice > max) nice = max;
+  if (best >= max) return best;
+  do {
+    match = ds->window+cur;
+    if (match[best]!=scan[best] || *match!=*scan || match[1]!=scan[1]) continue;
+
+    // Compare 8 bytes at a time, then find the mismatch
+    for (len = 2; len+8<=max; len += 8) {
+      unsigned long long a, b;
+
+      memcpy(&a, match+len, 8);
+      memcpy(&b, scan+len, 8);
+      if (a != b) break;
+    }
+    while (len<max && match[len]==scan[len]) len++;
+
+    if (len>best) {
+      ds->match_start = cur;
+      if ((best = len)>=nice) break;
+    }
+  } while ((cur = ds->prev[cur&(WSIZE-1)])>limit && --chain);
+
+  return best;
+}
+
+// Reset deflate state and set compression level. If dict isn't NULL, the
+// first dictlen bytes of it are history that matches can refer back to.
+static void deflate_reset(struct deflate *ds, int level, char *dict,
+  int dictlen)
+{
+  unsigned short *lv = deflate_levels[(ds->level = level)-1];
+  int i;
+
+  ds->good = lv[0];
+  ds->lazy = lv[1];
+  ds->nice = lv[2];
+  ds->chain = lv[3];
+  ds->lookahead = ds->eof = ds->syms = 0;
+  ds->match_length = 2;
+  memset(ds->head, 0, WSIZE*sizeof(short));
+  memset(ds->litfreq, 0, sizeof(ds->litfreq));
+  memset(ds->distfreq, 0, sizeof(ds->distfreq));
+  if (dictlen > WSIZE) {
+    dict += dictlen-WSIZE;
+    dictlen = WSIZE;
+  }
+  if (dictlen) memcpy(ds->window, dict, dictlen);
+  ds->strstart = ds->block_start = dictlen;
+  for (i = 0; i+2<dictlen; i++) insert_hash(ds, i);
+}
+
+// Deflate input to bitbuf. Greedy matching for levels 1-3, otherwise
+// check whether the next position has a longer match before emitting one.
+// If !final, end with an empty stored block to byte align the output.
+static void deflate(struct deflate *ds, struct bitbuf *bb, int final)
+{
+  unsigned hh, prev_match, max_insert;
+  int avail = 0, full, level = ds->level;
+
+  for (;;) {
+    if (ds->lookahead < MIN_LOOKAHEAD) {
+      fill_window(ds);
+      if (!ds->lookahead) break;
+    }
+    hh = ds->lookahead>=3 ? insert_hash(ds, ds->strstart) : 0;
+
+    if (level<4) {
+      ds->prev_length = ds->match_length = 2;
+      if (hh && ds->strstart-hh<=MAX_DIST) ds->match_length = longest_match(ds, hh);
+      if (ds->match_length>=3) {
+        full = deflate_sym(ds, ds->strstart-ds->match_start, ds->match_length);
+        ds->lookahead -= ds->match_length;
+        if (ds->match_length<=ds->lazy && ds->lookahead>=3) {
+          while (--ds->match_length) insert_hash(ds, ++ds->strstart);
+          ds->strstart++;
+        } else ds->strstart += ds->match_length;
+      } else {
+        full = deflate_sym(ds, 0, ds->window[ds->strstart++]);
+        ds->lookahead--;
+      }
+      if (full) deflate_block(ds, bb, 0);
+
+      continue;
+    }
+
+    ds->prev_length = ds->match_length;
+    prev_match = ds->match_start;
+    ds->match_length = 2;
+    if (hh && ds->prev_length<ds->lazy && ds->strstart-hh<=MAX_DIST) {
+      ds->match_length = longest_match(ds, hh);
+      // A distant 3 byte match costs more than three literals
+      if (ds->match_length==3 && ds->strstart-ds->match_start>4096)
+        ds->match_length = 2;
+    }
+
+    // If previous match was at least as good as this one, use it.
+    if (ds->prev_length>=3 && ds->match_length<=ds->prev_length) {
+      max_insert = ds->strstart+ds->lookahead-3;
+      full = deflate_sym(ds, ds->strstart-1-prev_match, ds->prev_length);
+      ds->lookahead -= ds->prev_length-1;
+      ds->prev_length -= 2;
+      do if (++ds->strstart <= max_insert) insert_hash(ds, ds->strstart);
+      while (--ds->prev_length);
+      avail = 0;
+      ds->match_length = 2;
+      ds->strstart++;
+      if (full) deflate_block(ds, bb, 0);
+
+    // Otherwise emit previous byte as a literal and try again one later.
+    } else {
+      if (avail && deflate_sym(ds, 0, ds->window[ds->strstart-1]))
+        deflate_block(ds, bb, 0);
+      avail = 1;
+      ds->strstart++;
+      ds->lookahead--;
+    }
+  }
+  if (avail) deflate_sym(ds, 0, ds->window[ds->strstart-1]);
+  deflate_block(ds, bb, final);
+  if (!final) {
+    bitbuf_put(bb, 0, 3);
+    bitbuf_put(bb, 0, (8-bb->bitpos)&7);
+    bitbuf_put(bb, 0xffff0000, 32);
+  }
   bitbuf_flush(bb);
 }
 
+// compress needs a 64k window (plus room to compare past its end), 32k
+// entry hash head and chain tables, and the symbol buffer.
+static struct deflate *deflate_alloc(void)
+{
+  struct deflate *ds = xzalloc(sizeof(struct deflate));
+  int i;
+
+  ds->window = xzalloc(2*WSIZE+258);
+  ds->head = xmalloc(2*WSIZE*sizeof(short));
+  ds->prev = ds->head+WSIZE;
+  ds->lc = xmalloc(2*SYMBUF*sizeof(short));
+  ds->dist = ds->lc+SYMBUF;
+  for (i=0; i<288; i++) ds->fixbits[i] = 8 + (i>143) - ((i>255)<<1) + (i>279);
+  memset(ds->fixbits+288, 5, 30);
+  len2code(ds->fixbits, ds->fixcodes, 288);
+  len2code(ds->fixbits+288, ds->fixcodes+288, 30);
+
+  return ds;
+}
+
 // Allocate memory for deflate/inflate.
 static void init_deflate(int compress)
 {
   int i, n = 1;
 
-  // compress needs 64k data and 32k each for hashhead and hashchain.
-  // decompress just needs 32k data.
-  TT.data = xmalloc(32768*(compress ? 4 : 1));
-  if (compress) {
-    TT.hashhead = (unsigned short *)(TT.data + 65536);
-    TT.hashchain = (unsigned short *)(TT.data + 65536 + 32768);
+  // decompress needs an output buffer with 32k of history at the start,
+  // and huffman decoding tables.
+  if (compress) TT.ds = deflate_alloc();
+  else {
+    TT.data = xmalloc(INFLATE_OUT+(2*LITHUFF+2*DISTHUFF+128)*sizeof(unsigned));
+    TT.lithuff = (unsigned *)(TT.data+INFLATE_OUT);
+    TT.fixlithuff = TT.lithuff+LITHUFF;
+    TT.disthuff = TT.fixlithuff+LITHUFF;
+    TT.fixdisthuff = TT.disthuff+DISTHUFF;
+    TT.clhuff = TT.fixdisthuff+DISTHUFF;
   }
 
   // Calculate lenbits, lenbase, distbits, distbase
@@ -486,11 +989,22 @@ static void init_deflate(int compress)
     TT.distbits[i] = n;
   }
 
+  // Reverse lookups from match length and distance-1 to symbol for deflate.
+  // Distances past 256 are looked up 128 at a time.
+  for (i = 0; i<29; i++)
+    for (n = TT.lenbase[i]; n<TT.lenbase[i]+(1<<TT.lenbits[i]) && n<259; n++)
+      TT.lencode[n-3] = i;
+  for (i = 0; i<30; i++)
+    for (n = TT.distbase[i]-1; n<TT.distbase[i]-1+(1<<TT.distbits[i]); n++)
+      TT.distcode[n<256 ? n : 256+(n>>7)] = i;
+
   // Init fixed huffman tables
-  for (i=0; i<288; i++) toybuf[i] = 8 + (i>143) - ((i>255)<<1) + (i>279);
-  len2huff(TT.fixlithuff = ((struct huff *)toybuf)+3, toybuf, 288);
-  memset(toybuf, 5, 30);
-  len2huff(TT.fixdisthuff = ((struct huff *)toybuf)+4, toybuf, 30);
+  if (!compress) {
+    for (i=0; i<288; i++) toybuf[i] = 8 + (i>143) - ((i>255)<<1) + (i>279);
+    len2huff(TT.fixlithuff, toybuf, 288, 10);
+    memset(toybuf, 5, 30);
+    len2huff(TT.fixdisthuff, toybuf, 30, 8);
+  }
 }
 
 // Return true/false whether we consumed a gzip header.
@@ -513,14 +1027,144 @@ static int is_gzip(struct bitbuf *bb)
 }
 
 void gzip_crc(char *data, int len)
+{
+  TT.crc = crc32_le(TT.crc_table, TT.crc, data, len);
+  TT.len += len;
+}
+
+// Block parallel gzip: input is split into 128k chunks, each compressed by a
+// worker thread using the 32k before it as a dictionary. Every chunk but the
+// last ends byte aligned (with an empty stored block), so concatenating the
+// results in order gives one deflate stream.
+
+#define GZCHUNK (128*1024)
+
+struct gzjob {
+  char *in;            // dictionary followed by chunk data
+  int dictlen, len, last, done;
+  struct bitbuf *bb;
+  unsigned crc;
+};
+
+// Multiply vector by 32x32 bit matrix over GF(2)
+static unsigned gf2_times(unsigned *mat, unsigned vec)
+{
+  unsigned sum = 0;
+
+  for (; vec; vec >>= 1, mat++) if (vec&1) sum ^= *mat;
+
+  return sum;
+}
+
+static void gf2_square(unsigned *square, unsigned *mat)
 {
   int i;
-  unsigned crc, *crc_table = (unsigned *)(toybuf+sizeof(toybuf)-1024);
 
-  crc = TT.crc;
-  for (i=0; i<len; i++) crc = crc_table[(crc^data[i])&0xff] ^ (crc>>8);
-  TT.crc = crc;
-  TT.len += len;
+  for (i = 0; i<32; i++) square[i] = gf2_times(mat, mat[i]);
+}
+
+// Return crc32 of A+B given crc32 of A, crc32 of B, and length of B. Appending
+// a zero bit is a linear operator on the crc, so build the operator for
+// len2 zero bytes by repeated squaring and apply it to crc1.
+static unsigned crc32_combine(unsigned crc1, unsigned crc2, long long len2)
+{
+  unsigned even[32], odd[32], row = 1;
+  int i;
+
+  if (!len2) return crc1;
+
+  // Operator for one zero bit, then two, then four
+  odd[0] = 0xedb88320;
+  for (i = 1; i<32; i++, row <<= 1) odd[i] = row;
+  gf2_square(even, odd);
+  gf2_square(odd, even);
+
+  // Apply operators for each set bit of len2 (in bytes, so start at 8 bits)
+  for (;;) {
+    gf2_square(even, odd);
+    if (len2&1) crc1 = gf2_times(even, crc1);
+    if (!(len2 >>= 1)) break;
+    gf2_square(odd, even);
+    if (len2&1) crc1 = gf2_times(odd, crc1);
+    if (!(len2 >>= 1)) break;
+  }
+
+  return crc1^crc2;
+}
+
+static void *gzip_worker(void *arg)
+{
+  struct deflate *ds = arg;
+  struct gzjob *job;
+
+  for (;;) {
+    pthread_mutex_lock(&TT.mutex);
+    while (TT.taken == TT.submitted) pthread_cond_wait(&TT.cond, &TT.mutex);
+    job = ((struct gzjob *)TT.jobs)+TT.taken++%(2*TT.threads);
+    pthread_mutex_unlock(&TT.mutex);
+
+    job->crc = ~crc32_le(TT.crc_table, ~0, job->in+job->dictlen, job->len);
+    job->bb = bitbuf_init(-1, 65536);
+    deflate_reset(ds, TT.level, job->in, job->dictlen);
+    ds->in = (unsigned char *)job->in+job->dictlen;
+    ds->inlen = job->len;
+    deflate(ds, job->bb, job->last);
+
+    pthread_mutex_lock(&TT.mutex);
+    job->done = 1;
+    pthread_cond_broadcast(&TT.cond);
+    pthread_mutex_unlock(&TT.mutex);
+  }
+
+  return 0;
+}
+
+// Wait for job to finish, write its output, and add it to the crc and length
+static void gzip_collect(struct gzjob *job)
+{
+  pthread_mutex_lock(&TT.mutex);
+  while (!job->done) pthread_cond_wait(&TT.cond, &TT.mutex);
+  pthread_mutex_unlock(&TT.mutex);
+
+  xwrite(1, job->bb->out, job->bb->outlen);
+  TT.crc = ~crc32_combine(~TT.crc, job->crc, job->len);
+  TT.len += job->len;
+  free(job->bb->out);
+  free(job->bb);
+}
+
+// Feed chunks of fd to the worker threads, writing results in order.
+static void gzip_parallel(int fd)
+{
+  struct gzjob *job, *prev = 0, *jobs = TT.jobs;
+  long seq, ring = 2*TT.threads;
+
+  // Workers are idle between files, but still read these under the lock.
+  pthread_mutex_lock(&TT.mutex);
+  TT.submitted = TT.taken = 0;
+  pthread_mutex_unlock(&TT.mutex);
+  for (seq = 0;; seq++) {
+    job = jobs+seq%ring;
+    if (seq >= ring) gzip_collect(job);
+    if (!job->in) job->in = xmalloc(WSIZE+GZCHUNK);
+
+    // Previous chunk was full size, so its last 32k is our dictionary.
+    if ((job->dictlen = prev ? WSIZE : 0))
+      memcpy(job->in, prev->in+prev->dictlen+prev->len-WSIZE, WSIZE);
+    job->len = readall(fd, job->in+job->dictlen, GZCHUNK);
+    if (job->len < 0) perror_exit("read");
+    job->last = job->len != GZCHUNK;
+    job->done = 0;
+
+    pthread_mutex_lock(&TT.mutex);
+    TT.submitted++;
+    pthread_cond_broadcast(&TT.cond);
+    pthread_mutex_unlock(&TT.mutex);
+    if (job->last) break;
+    prev = job;
+  }
+  for (seq = seq<ring ? 0 : seq-ring+1; seq<TT.submitted; seq++)
+    gzip_collect(jobs+seq%ring);
 }
 
 static void do_gzip(int fd, char *name)
@@ -529,17 +1173,24 @@ static void do_gzip(int fd, char *name)
 
   // Header from RFC 1952 section 2.2:
   // 2 ID bytes (1F, 8b), gzip method byte (8=deflate), FLAG byte (none),
-  // 4 byte MTIME (zeroed), Extra Flags (2=maximum compression),
+  // 4 byte MTIME (zeroed), Extra Flags (2=maximum compression, 4=fastest),
   // Operating System (FF=unknown)
  
-  TT.infd = fd;
-  xwrite(bb->fd, "\x1f\x8b\x08\0\0\0\0\0\x02\xff", 10);
+  ((struct deflate *)TT.ds)->infd = fd;
+  xwrite(bb->fd, TT.level==9 ? "\x1f\x8b\x08\0\0\0\0\0\x02\xff"
+    : TT.level==1 ? "\x1f\x8b\x08\0\0\0\0\0\x04\xff"
+    : "\x1f\x8b\x08\0\0\0\0\0\0\xff", 10);
 
-  // Use last 1k of toybuf for little endian crc table
-  crc_init((unsigned *)(toybuf+sizeof(toybuf)-1024), 1);
+  crc32_init(TT.crc_table, 1);
   TT.crcfunc = gzip_crc;
+  TT.crc = ~0;
+  TT.len = 0;
 
-  deflate(bb);
+  if (TT.threads > 1) gzip_parallel(fd);
+  else {
+    deflate_reset(TT.ds, TT.level, 0, 0);
+    deflate(TT.ds, bb, 1);
+  }
 
   // tail: crc32, len32
 
@@ -553,20 +1204,19 @@ static void do_gzip(int fd, char *name)
 
 static void do_zcat(int fd, char *name)
 {
-  struct bitbuf *bb = bitbuf_init(fd, sizeof(toybuf));
+  struct bitbuf *bb = bitbuf_init(fd, 65536);
 
   if (!is_gzip(bb)) error_exit("not gzip");
   TT.outfd = 1;
 
-  // Use last 1k of toybuf for little endian crc table
-  crc_init((unsigned *)(toybuf+sizeof(toybuf)-1024), 1);
+  crc32_init(TT.crc_table, 1);
   TT.crcfunc = gzip_crc;
 
   inflate(bb);
 
   // tail: crc32, len32
 
-  bitbuf_skip(bb, (8-bb->bitpos)&7);
+  bitbuf_skip(bb, bb->bitcnt&7);
   if (~TT.crc != bitbuf_get(bb, 32) || TT.len != bitbuf_get(bb, 32))
     error_exit("bad crc");
   free(bb);
@@ -598,9 +1248,29 @@ void gunzip_main(void)
   loopfiles(toys.optargs, do_zcat);
 }
 
+#define CLEANUP_compress
+#define FOR_gzip
+#include "generated/flags.h"
+
 void gzip_main(void)
 {
+  int i;
+
+  // Last -1 through -9 wins, default 6
+  for (TT.level = 6, i = 1; i<10; i++)
+    if (toys.optflags & (FLAG_1>>(i-1))) TT.level = i;
   init_deflate(1);
 
+  // Start worker threads, each with its own deflate state
+  if (TT.threads > 1) {
+    pthread_t thread;
+
+    TT.jobs = xzalloc(2*TT.threads*sizeof(struct gzjob));
+    pthread_mutex_init(&TT.mutex, 0);
+    pthread_cond_init(&TT.cond, 0);
+    for (i = 0; i<TT.threads; i++)
+      xpthread_create(&thread, gzip_worker, deflate_alloc());
+  }
+
   loopfiles(toys.optargs, do_gzip);
 }
@@ -7,13 +7,13 @@
  * For writing to external program
  * http://www.gnu.org/software/tar/manual/html_node/Writing-to-an-External-Program.html
 
-USE_TAR(NEWTOY(tar, "&(no-recursion)(numeric-owner)(no-same-permissions)(overwrite)(exclude)*(to-command):o(no-same-owner)p(same-permissions)k(keep-old)c(create)|h(dereference)x(extract)|t(list)|v(verbose)z(gzip)O(to-stdout)m(touch)X(exclude-from)*T(files-from)*C(directory):f(file):[!txc]", TOYFLAG_USR|TOYFLAG_BIN))
+USE_TAR(NEWTOY(tar, "&(no-recursion)(numeric-owner)(no-same-permissions)(overwrite)(exclude)*(to-command):o(no-same-owner)p(same-permissions)k(keep-old)c(create)|h(dereference)x(extract)|t(list)|v(verbose)J(xz)j(bzip2)z(gzip)O(to-stdout)m(touch)X(exclude-from)*T(files-from)*C(directory):f(file):[!txc][!zjJ]", TOYFLAG_USR|TOYFLAG_BIN))
 
 config TAR
   bool "tar"
   default n
   help
-    usage: tar -[cxtzhmvO] [-X FILE] [-T FILE] [-f TARFILE] [-C DIR]
+    usage: tar -[cxtzjJhmvO] [-X FILE] [-T FILE] [-f TARFILE] [-C DIR]
 
     Create, extract, or list files from a tar file
 
@@ -26,15 +26,20 @@ config TAR
     v Verbose
     x Extract
     z (De)compress using gzip
+    j (De)compress using bzip2
+    J (De)compress using xz
     C Change to DIR before operation
     O Extract to stdout
     exclude=FILE File to exclude
     X File with names to exclude
     T File with names to include
+
+    Compressed archives are detected when extracting or listing.
 */
 
 #define FOR_tar
 #include "toys.h"
+#include <sys/sendfile.h>
 
 GLOBALS(
   char *fname;
@@ -45,7 +50,9 @@ GLOBALS(
   struct arg_list *exc;
 
   struct arg_list *inc, *pass;
-  void *inodes, *handle;
+  struct inoset inodes;
+  void *handle;
+  pid_t filter;
 )
 
 struct tar_hdr {
@@ -54,9 +61,21 @@ struct tar_hdr {
        prefix[155], padd[12];
 };
 
+// GNU sparse file header fields, in place of tar_hdr prefix
+struct tar_sparse {
+  char atime[12], ctime[12], offset[12], longnames[4], unused, sp[4][2][12],
+       isextended, realsize[12];
+};
+
+// Extension block for sparse map entries that don't fit in the header
+struct tar_sparse_ext {
+  char sp[21][2][12], isextended, padd[7];
+};
+
 struct file_header {
   char *name, *link_target, *uname, *gname;
-  off_t size;
+  off_t size, realsize, *sparse;
+  int sparse_len;
   uid_t uid;
   gid_t gid;
   mode_t mode;
@@ -71,53 +90,69 @@ struct archive_handler {
   void (*extract_handler)(struct archive_handler*);
 };
 
-struct inode_list {
-  struct inode_list *next;
-  char *arg;
-  ino_t ino;
-  dev_t dev;
-};
-
+// Copy size bytes from src to dst in large chunks, letting the kernel move
+// the data with sendfile() when it can (src is a file).
 static void copy_in_out(int src, int dst, off_t size)
 {
-  int i, rd, rem = size%512, cnt;
-  
-  cnt = size/512 + (rem?1:0);
-
-  for (i = 0; i < cnt; i++) {
-    rd = (i == cnt-1 && rem) ? rem : 512;
-    xreadall(src, toybuf, rd);
-    writeall(dst, toybuf, rd);
+  char buf[65536];
+  long len;
+  int kernel = dst >= 0;
+
+  while (size > 0) {
+    if (kernel) {
+      len = sendfile(dst, src, 0, size > 1<<30 ? 1<<30 : size);
+      if (len > 0) {
+        size -= len;
+        continue;
+      }
+      if (!len) error_exit("short read");
+      kernel = 0;
+    }
+    len = size > sizeof(buf) ? sizeof(buf) : size;
+    xreadall(src, buf, len);
+    writeall(dst, buf, len);
+    size -= len;
+  }
+}
+
+// Write len zero bytes to fd.
+static void write_zeroes(int fd, off_t len)
+{
+  memset(toybuf, 0, sizeof(toybuf));
+  while (len > 0) {
+    writeall(fd, toybuf, len > sizeof(toybuf) ? sizeof(toybuf) : len);
+    len -= sizeof(toybuf);
   }
 }
 
-//convert to octal
+//convert to octal, or GNU base-256 if it doesn't fit
 static void itoo(char *str, int len, off_t val)
 {
   char *t, tmp[sizeof(off_t)*3+1];
-  int cnt  = sprintf(tmp, "%0*llo", len, (unsigned long long)val);
+  int cnt;
+
+  if (val<0 || (len<sizeof(off_t)*3 && val>>(3*len))) {
+    for (cnt = len; cnt--; val >>= 8) str[cnt] = val;
+    *str |= 128;
+
+    return;
+  }
+  cnt = sprintf(tmp, "%0*llo", len, (unsigned long long)val);
 
   t = tmp + cnt - len;
   if (*t == '0') t++;
   memcpy(str, t, len);
 }
 
-static struct inode_list *seen_inode(void **list, struct stat *st, char *name)
+// Return name we first saw this inode+dev under, else remember it and
+// return NULL.
+static char *seen_inode(struct inoset *set, struct stat *st, char *name)
 {
-  if (!st) llist_traverse(*list, llist_free_arg);
-  else if (!S_ISDIR(st->st_mode) && st->st_nlink > 1) {
-    struct inode_list *new;
-
-    for (new = *list; new; new = new->next)
-      if(new->ino == st->st_ino && new->dev == st->st_dev)
-        return new;
-
-    new = xzalloc(sizeof(*new));
-    new->ino = st->st_ino;
-    new->dev = st->st_dev;
-    new->arg = xstrdup(name);
-    new->next = *list;
-    *list = new;
+  char **arg;
+
+  if (!S_ISDIR(st->st_mode) && st->st_nlink > 1) {
+    if (inoset_add(set, st, (void ***)&arg)) return *arg;
+    *arg = xstrdup(name);
   }
   return 0;
 }
@@ -158,14 +193,57 @@ static int filter(struct arg_list *lst, char *name)
   return 0;
 }
 
+// Find the data extents of a file with holes (using SEEK_DATA/SEEK_HOLE),
+// returning the number of offset/length pairs stored in *map, the last
+// of which is zero length at the end of any trailing hole. Returns 0 if the
+// file has no holes (or we can't tell).
+static int sparse_map(int fd, off_t size, off_t **map)
+{
+  off_t pos = 0, end = 0, *sp = 0;
+  int len = 0;
+
+  for (;;) {
+    if (pos < size && 0>(end = lseek(fd, pos, SEEK_DATA))) {
+      if (errno != ENXIO) {
+        free(sp);
+
+        return 0;
+      }
+      end = size;
+    }
+    if (!(len&31)) sp = xrealloc(sp, (len+32)*2*sizeof(off_t));
+    if (pos >= size || end >= size) {
+      sp[2*len] = size;
+      sp[2*len+1] = 0;
+      len++;
+      break;
+    }
+    pos = end;
+    end = lseek(fd, pos, SEEK_HOLE);
+    if (end<pos || end>size) end = size;
+    sp[2*len] = pos;
+    sp[2*len+1] = end-pos;
+    len++;
+    if ((pos = end) == size) break;
+  }
+  xlseek(fd, 0, SEEK_SET);
+  if (len == 1 && !*sp) len = 0;
+  if (!len) free(sp);
+  else *map = sp;
+
+  return len;
+}
+
 static void add_file(struct archive_handler *tar, char **nam, struct stat *st)
 {
   struct tar_hdr hdr;
+  struct tar_sparse *gnu = (void *)hdr.prefix;
+  struct tar_sparse_ext ext;
   struct passwd *pw;
   struct group *gr;
-  struct inode_list *node;
-  int i, fd =-1;
-  char *c, *p, *name = *nam, *lnk, *hname, buf[512] = {0,};
+  int i, j, fd =-1, sparse = 0;
+  off_t *map = 0, len = st->st_size;
+  char *c, *p, *name = *nam, *lnk, *hname, *hlink, buf[512] = {0,};
   unsigned int sum = 0;
   static int warn = 1;
 
@@ -198,21 +276,32 @@ static void add_file(struct archive_handler *tar, char **nam, struct stat *st)
   itoo(hdr.mtime, sizeof(hdr.mtime), st->st_mtime);
   for (i=0; i<sizeof(hdr.chksum); i++) hdr.chksum[i] = ' ';
 
-  if ((node = seen_inode(&TT.inodes, st, hname))) {
+  if ((hlink = seen_inode(&TT.inodes, st, hname))) {
     //this is a hard link
     hdr.type = '1';
-    if (strlen(node->arg) > sizeof(hdr.link))
+    if (strlen(hlink) > sizeof(hdr.link))
       write_longname(tar, hname, 'K'); //write longname LINK
-    xstrncpy(hdr.link, node->arg, sizeof(hdr.link));
+    xstrncpy(hdr.link, hlink, sizeof(hdr.link));
   } else if (S_ISREG(st->st_mode)) {
     hdr.type = '0';
-    if (st->st_size <= (off_t)0777777777777LL)
-      itoo(hdr.size, sizeof(hdr.size), st->st_size);
-    else {
-      error_msg("can't store file '%s' of size '%lld'\n",
-                hname, (unsigned long long)st->st_size);
+    if ((fd = open(name, O_RDONLY)) < 0) {
+      perror_msg("can't open '%s'", name);
       return;
     }
+
+    // Only files with fewer blocks than their size need have holes.
+    if (st->st_blocks*512 < st->st_size
+        && (sparse = sparse_map(fd, st->st_size, &map))) {
+      hdr.type = 'S';
+      for (len = i = 0; i<sparse; i++) len += map[2*i+1];
+      itoo(gnu->realsize, sizeof(gnu->realsize), st->st_size);
+      for (i = 0; i<sparse && i<4; i++) {
+        itoo(gnu->sp[i][0], sizeof(gnu->sp[i][0]), map[2*i]);
+        itoo(gnu->sp[i][1], sizeof(gnu->sp[i][1]), map[2*i+1]);
+      }
+      gnu->isextended = sparse>4;
+    }
+    itoo(hdr.size, sizeof(hdr.size), len);
   } else if (S_ISLNK(st->st_mode)) {
     hdr.type = '2'; //'K' long link
     if (!(lnk = xreadlink(name))) {
@@ -251,15 +340,25 @@ static void add_file(struct archive_handler *tar, char **nam, struct stat *st)
   if (toys.optflags & FLAG_v) printf("%s\n",hname);
   writeall(tar->src_fd, (void*)&hdr, 512);
 
-  //write actual data to archive
-  if (hdr.type != '0') return; //nothing to write
-  if ((fd = open(name, O_RDONLY)) < 0) {
-    perror_msg("can't open '%s'", name);
-    return;
+  //rest of sparse map, then actual data
+  for (i = 4; i<sparse; i += 21) {
+    memset(&ext, 0, sizeof(ext));
+    for (j = 0; j<21 && i+j<sparse; j++) {
+      itoo(ext.sp[j][0], sizeof(ext.sp[j][0]), map[2*(i+j)]);
+      itoo(ext.sp[j][1], sizeof(ext.sp[j][1]), map[2*(i+j)+1]);
+    }
+    ext.isextended = i+21<sparse;
+    writeall(tar->src_fd, (void*)&ext, 512);
   }
-  copy_in_out(fd, tar->src_fd, st->st_size);
-  if (st->st_size%512) writeall(tar->src_fd, buf, (512-(st->st_size%512)));
+  if (fd == -1) return; //nothing to write
+  if (!sparse) copy_in_out(fd, tar->src_fd, len);
+  else for (i = 0; i<sparse; i++) {
+    xlseek(fd, map[2*i], SEEK_SET);
+    copy_in_out(fd, tar->src_fd, map[2*i+1]);
+  }
+  if (len%512) writeall(tar->src_fd, buf, (512-(len%512)));
   close(fd);
+  free(map);
 }
 
 static int add_to_tar(struct dirtree *node)
@@ -282,37 +381,82 @@ static int add_to_tar(struct dirtree *node)
   return ((DIRTREE_RECURSE | ((toys.optflags & FLAG_h)?DIRTREE_SYMFOLLOW:0)));
 }
 
-static void compress_stream(struct archive_handler *tar_hdl)
+// Compression programs (toybox builtins when available), by flag and magic
+static struct tar_filter {
+  int flag, len;
+  char *magic, *zip, *unzip;
+} tar_filters[] = {
+  {FLAG_z, 2, "\x1f\x8b", "gzip", "zcat"},
+  {FLAG_j, 3, "BZh", "bzip2", "bzcat"},
+  {FLAG_J, 6, "\3757zXZ", "xz", "xzcat"}
+};
+
+// Put (de)compressor in a child process between the archive and src_fd.
+// When extracting from a pipe we may already have read len bytes of
+// compressed data, which another child feeds back in front of the rest.
+static void tar_filter(struct archive_handler *tar_hdl, struct tar_filter *f,
+  int unzip, char *data, int len)
 {
-  int pipefd[2];
-  pid_t cpid;
+  char *argv[] = {unzip ? f->unzip : f->zip, unzip ? 0 : "-f", 0};
+  int pipefd[2], fd = tar_hdl->src_fd;
 
   xpipe(pipefd);
-
   signal(SIGPIPE, SIG_IGN);
-  cpid = fork();
-  if (cpid == -1) perror_exit("fork");
-
-  if (!cpid) {    /* Child reads from pipe */
-    char *argv[] = {"gzip", "-f", NULL};
-    xclose(pipefd[1]); /* Close unused write*/
-    dup2(pipefd[0], 0);
-    dup2(tar_hdl->src_fd, 1); //write to tar fd
+  if (!(TT.filter = xfork())) {
+    xclose(pipefd[!unzip]);
+    if (len) {
+      int feed[2];
+
+      xpipe(feed);
+      if (!xfork()) {
+        xclose(pipefd[1]);
+        xclose(feed[0]);
+        writeall(feed[1], data, len);
+        xsendfile(fd, feed[1]);
+        _exit(0);
+      }
+      xclose(feed[1]);
+      fd = feed[0];
+    }
+    dup2(unzip ? fd : pipefd[0], 0);
+    dup2(unzip ? pipefd[1] : fd, 1);
+    if (pipefd[unzip] > 1) xclose(pipefd[unzip]);
+    signal(SIGPIPE, SIG_DFL);
     xexec(argv);
-  } else {
-    xclose(pipefd[0]);          /* Close unused read end */
-    dup2(pipefd[1], tar_hdl->src_fd); //write to pipe
   }
+  xclose(pipefd[unzip]);
+  dup2(pipefd[!unzip], tar_hdl->src_fd);
+  xclose(pipefd[!unzip]);
 }
 
-static void extract_to_stdout(struct archive_handler *tar)
+// Copy file data from the archive to dst, expanding sparse files by seeking
+// over their holes (if seek, leaving them unallocated) or writing zeroes.
+static void copy_data(struct archive_handler *tar, int dst, int seek)
 {
   struct file_header *file_hdr = &tar->file_hdr;
-
-  copy_in_out(tar->src_fd, 0, file_hdr->size);
+  off_t pos = 0, *sp = file_hdr->sparse;
+  int i;
+
+  if (!sp) copy_in_out(tar->src_fd, dst, file_hdr->size);
+  else {
+    for (i = 0; i<file_hdr->sparse_len; i++, sp += 2) {
+      if (seek) lseek(dst, sp[0], SEEK_SET);
+      else write_zeroes(dst, sp[0]-pos);
+      copy_in_out(tar->src_fd, dst, sp[1]);
+      pos = sp[0]+sp[1];
+    }
+    if (!seek) write_zeroes(dst, file_hdr->realsize-pos);
+    else if (dst != -1 && ftruncate(dst, file_hdr->realsize))
+      perror_msg("%s", file_hdr->name);
+  }
   tar->offset += file_hdr->size;
 }
 
+static void extract_to_stdout(struct archive_handler *tar)
+{
+  copy_data(tar, 1, 0);
+}
+
 static void extract_to_command(struct archive_handler *tar)
 {
   int pipefd[2], status = 0;
@@ -349,8 +493,7 @@ static void extract_to_command(struct archive_handler *tar)
     xexec(argv);
   } else {
     xclose(pipefd[0]);  // Close unused read end
-    copy_in_out(tar->src_fd, pipefd[1], file_hdr->size);
-    tar->offset += file_hdr->size;
+    copy_data(tar, pipefd[1], 0);
     xclose(pipefd[1]);
     waitpid(cpid, &status, 0);
     if (WIFSIGNALED(status))
@@ -418,8 +561,7 @@ static void extract_to_disk(struct archive_handler *tar)
 
   //copy file....
 COPY:
-  copy_in_out(tar->src_fd, dst_fd, file_hdr->size);
-  tar->offset += file_hdr->size;
+  copy_data(tar, dst_fd, 1);
   close(dst_fd);
 
   if (S_ISLNK(file_hdr->mode)) return;
@@ -484,39 +626,24 @@ static struct archive_handler *init_handler()
   return tar_hdl;
 }
 
-//convert octal to int
-static int otoi(char *str, int len)
+//convert octal (or GNU base-256, high bit of first byte set) to int
+static long long otoi(char *str, int len)
 {
-  long val;
+  long long val;
   char *endp, inp[len+1]; //1 for NUL termination
 
+  if (*str&128) {
+    // Remaining 7 bits of first byte are the sign and top of the value.
+    for (val = (signed char)(*(unsigned char *)str<<1)>>1; --len;)
+      val = (val<<8)|*(unsigned char *)++str;
+
+    return val;
+  }
   memcpy(inp, str, len);
   inp[len] = '\0'; //nul-termination made sure
-  val = strtol(inp, &endp, 8);
+  val = strtoll(inp, &endp, 8);
   if (*endp && *endp != ' ') error_exit("invalid param");
-  return (int)val;
-}
-
-static void extract_stream(struct archive_handler *tar_hdl)
-{
-  int pipefd[2];              
-  pid_t cpid;                 
-
-  if (pipe(pipefd) == -1) error_exit("pipe");
-
-  cpid = fork();
-  if (cpid == -1) perror_exit("fork");
-
-  if (!cpid) {    /* Child reads from pipe */
-    char *argv[] = {"gunzip", "-cf", "-", NULL};
-    xclose(pipefd[0]); /* Close unused read*/
-    dup2(tar_hdl->src_fd, 0);
-    dup2(pipefd[1], 1); //write to pipe
-    xexec(argv);
-  } else {
-    xclose(pipefd[1]);          /* Close unused read end */
-    dup2(pipefd[0], tar_hdl->src_fd); //read from pipe
-  }
+  return val;
 }
 
 static char *process_extended_hdr(struct archive_handler *tar, int size)
@@ -565,13 +692,47 @@ static void tar_skip(struct archive_handler *tar, int sz)
   tar->offset += sz;
 }
 
+// Read GNU sparse map from header and any extension blocks after it.
+static void read_sparse(struct archive_handler *tar, struct tar_hdr *hdr)
+{
+  struct file_header *file_hdr = &tar->file_hdr;
+  struct tar_sparse *gnu = (void *)hdr->prefix;
+  struct tar_sparse_ext ext;
+  char (*sp)[2][12] = gnu->sp;
+  int i, len = 4, more = gnu->isextended;
+  off_t pos = 0, total = 0, *map;
+
+  file_hdr->realsize = otoi(gnu->realsize, sizeof(gnu->realsize));
+  for (;;) {
+    for (i = 0; i<len && *sp[i][0]; i++) {
+      if (!(file_hdr->sparse_len&31))
+        file_hdr->sparse = xrealloc(file_hdr->sparse,
+          (file_hdr->sparse_len+32)*2*sizeof(off_t));
+      map = file_hdr->sparse+2*file_hdr->sparse_len++;
+      map[0] = otoi(sp[i][0], sizeof(sp[i][0]));
+      map[1] = otoi(sp[i][1], sizeof(sp[i][1]));
+      if (map[0] < pos || map[1] < 0) error_exit("bad sparse map");
+      pos = map[0]+map[1];
+      total += map[1];
+    }
+    if (!more) break;
+    xreadall(tar->src_fd, &ext, 512);
+    tar->offset += 512;
+    sp = ext.sp;
+    len = 21;
+    more = ext.isextended;
+  }
+  if (total != file_hdr->size || pos > file_hdr->realsize)
+    error_exit("bad sparse map");
+}
+
 static void unpack_tar(struct archive_handler *tar_hdl)
 {
   struct tar_hdr tar;
   struct file_header *file_hdr;
   int i, j, maj, min, sz, e = 0;
   unsigned int cksum;
-  unsigned char *gzMagic;
+  struct tar_filter *f;
   char *longname = NULL, *longlink = NULL;
 
   while (1) {
@@ -595,14 +756,18 @@ static void unpack_tar(struct archive_handler *tar_hdl)
     if (strncmp(tar.magic, "ustar", 5)) {
       //try detecting by reading magic
 CHECK_MAGIC:
-      gzMagic = (unsigned char*)&tar;
-      if ((gzMagic[0] == 0x1f) && (gzMagic[1] == 0x8b) 
-          && !lseek(tar_hdl->src_fd, -i, SEEK_CUR)) {
-        tar_hdl->offset -= i;
-        extract_stream(tar_hdl);
-        continue;
-      }
-      error_exit("invalid tar format");
+      for (f = 0, j = 0; !TT.filter && j<ARRAY_LEN(tar_filters); j++)
+        if (i >= tar_filters[j].len
+          && !memcmp(&tar, tar_filters[j].magic, tar_filters[j].len))
+            f = tar_filters+j;
+      if (!f) error_exit("invalid tar format");
+
+      // Rewind if we can, else hand what we read to the decompressor
+      tar_hdl->offset -= i;
+      if (lseek(tar_hdl->src_fd, -i, SEEK_CUR) < 0)
+        tar_filter(tar_hdl, f, 1, (void *)&tar, i);
+      else tar_filter(tar_hdl, f, 1, 0, 0);
+      continue;
     }
 
     for (j = 0; j<148; j++) cksum += (unsigned int)((char*)&tar)[j];
@@ -625,7 +790,7 @@ CHECK_MAGIC:
     min = otoi(tar.minor, sizeof(tar.minor));
     file_hdr->device = dev_makedev(maj, min);
 
-    if (tar.type <= '7') {
+    if (tar.type <= '7' || tar.type == 'S') {
       if (tar.link[0]) {
         sz = sizeof(tar.link);
         file_hdr->link_target = xmalloc(sz + 1);
@@ -634,7 +799,7 @@ CHECK_MAGIC:
       }
 
       file_hdr->name = xzalloc(256);// pathname supported size
-      if (tar.prefix[0]) {
+      if (tar.prefix[0] && tar.type != 'S') {
         memcpy(file_hdr->name, tar.prefix, sizeof(tar.prefix));
         sz = strlen(file_hdr->name);
         if (file_hdr->name[sz-1] != '/') file_hdr->name[sz] = '/';
@@ -666,6 +831,10 @@ CHECK_MAGIC:
       case '6':
         file_hdr->mode |= S_IFIFO;
         break;
+      case 'S':
+        file_hdr->mode |= S_IFREG;
+        read_sparse(tar_hdl, &tar);
+        break;
       case 'K':
         longlink = xzalloc(file_hdr->size +1);
         xread(tar_hdl->src_fd, longlink, file_hdr->size);
@@ -680,7 +849,6 @@ CHECK_MAGIC:
       case 'D':
       case 'M':
       case 'N':
-      case 'S':
       case 'V':
       case 'g':  // pax global header
         tar_skip(tar_hdl, file_hdr->size);
@@ -725,7 +893,8 @@ CHECK_MAGIC:
 
         mode_to_string(file_hdr->mode, perm);
         printf("%s %s/%s %9ld %d-%02d-%02d %02d:%02d:%02d ",perm,file_hdr->uname,
-            file_hdr->gname, (long)file_hdr->size, 1900+lc->tm_year,
+            file_hdr->gname, (long)(file_hdr->sparse ? file_hdr->realsize
+            : file_hdr->size), 1900+lc->tm_year,
             1+lc->tm_mon, lc->tm_mday, lc->tm_hour, lc->tm_min, lc->tm_sec);
       }
       printf("%s",file_hdr->name);
@@ -741,13 +910,15 @@ SKIP:
     free(file_hdr->link_target);
     free(file_hdr->uname);
     free(file_hdr->gname);
+    free(file_hdr->sparse);
   }
 }
 
 void tar_main(void)
 {
   struct archive_handler *tar_hdl;
-  int fd = 0;
+  struct tar_filter *f = 0;
+  int fd = 0, i;
   struct arg_list *tmp;
   char **args = toys.optargs;
 
@@ -770,6 +941,8 @@ void tar_main(void)
 
   tar_hdl = init_handler();
   tar_hdl->src_fd = fd;
+  for (i = 0; i<ARRAY_LEN(tar_filters); i++)
+    if (toys.optflags & tar_filters[i].flag) f = tar_filters+i;
 
   if ((toys.optflags & FLAG_x) || (toys.optflags & FLAG_t)) {
     if (toys.optflags & FLAG_O) tar_hdl->extract_handler = extract_to_stdout;
@@ -777,14 +950,14 @@ void tar_main(void)
       signal(SIGPIPE, SIG_IGN); //will be using pipe between child & parent
       tar_hdl->extract_handler = extract_to_command;
     }
-    if (toys.optflags & FLAG_z) extract_stream(tar_hdl);
+    if (f) tar_filter(tar_hdl, f, 1, 0, 0);
     unpack_tar(tar_hdl);
     for (tmp = TT.inc; tmp; tmp = tmp->next)
       if (!filter(TT.exc, tmp->arg) && !filter(TT.pass, tmp->arg))
         error_msg("'%s' not in archive", tmp->arg);
   } else if (toys.optflags & FLAG_c) {
     //create the tar here.
-    if (toys.optflags & FLAG_z) compress_stream(tar_hdl);
+    if (f) tar_filter(tar_hdl, f, 0, 0, 0);
     for (tmp = TT.inc; tmp; tmp = tmp->next) {
       TT.handle = tar_hdl;
       //recurse thru dir and add files to archive
@@ -793,7 +966,16 @@ void tar_main(void)
     }
     memset(toybuf, 0, 1024);
     writeall(tar_hdl->src_fd, toybuf, 1024);
-    seen_inode(&TT.inodes, 0, 0);
+    inoset_free(&TT.inodes, free);
+  }
+
+  // Wait for the (de)compressor to see the whole stream and exit
+  if (TT.filter) {
+    if (!(toys.optflags & FLAG_c))
+      while (read(tar_hdl->src_fd, toybuf, sizeof(toybuf)) > 0);
+    close(tar_hdl->src_fd);
+    tar_hdl->src_fd = -1;
+    if (xwaitpid(TT.filter) && !toys.exitval) toys.exitval = 1;
   }
 
   if (CFG_TOYBOX_FREE) {
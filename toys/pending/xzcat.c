@@ -15,11 +15,20 @@ config XZCAT
     usage: xzcat [filename...]
     
     Decompress listed files to stdout. Use stdin if no files listed.
+    Blocks of multi-block files are decoded in parallel.
 
 */
 #define FOR_xzcat
 #include "toys.h"
 
+GLOBALS(
+  int threads;
+  long submitted, taken;
+  struct xzjob *jobs;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+)
+
 // BEGIN xz.h
 
 /**
@@ -159,6 +168,17 @@ enum xz_ret xz_dec_run(struct xz_dec *s, struct xz_buf *b);
  */
 void xz_dec_reset(struct xz_dec *s);
 
+/**
+ * xz_dec_block() - Prepare to decode one Block of a seekable file
+ * @s:          Decoder state allocated using xz_dec_init()
+ * @check_type: Check ID from the Stream Header
+ *
+ * The input starts at the Block Header, and xz_dec_run() returns
+ * XZ_STREAM_END after the Block's Check field. This lets independent Blocks
+ * found through the Index be decoded in parallel.
+ */
+void xz_dec_block(struct xz_dec *s, int check_type);
+
 /**
  * xz_dec_end() - Free the memory allocated for the decoder state
  * @s:          Decoder state allocated using xz_dec_init(). If s is NULL,
@@ -171,134 +191,289 @@ void xz_dec_end(struct xz_dec *s);
  * calculation, the third argument must be zero. To continue the calculation,
  * the previously returned value is passed as the third argument.
  */
-static uint32_t xz_crc32_table[256];
+static uint32_t xz_crc32_table[8*256];
 
 uint32_t xz_crc32(const uint8_t *buf, size_t size, uint32_t crc)
 {
-  crc = ~crc;
+  return ~crc32_le(xz_crc32_table, ~crc, (void *)buf, size);
+}
+
+static uint64_t xz_crc64_table[256];
+
+
+// END xz.h
+
+// I/O buffer size for streaming decode
+#define XZ_IOBUF (1<<20)
+
+// Blocks decoding to more than XZ_BLOCKMAX go through the streaming decoder,
+// and at most XZ_INFLIGHT bytes of block input plus output wait in the ring
+// (of TT.threads+1 jobs) at once.
+#define XZ_BLOCKMAX (1<<25)
+#define XZ_INFLIGHT (1<<27)
+
+// One Block decoded by a worker thread
+struct xzjob {
+  uint8_t *in, *out;
+  size_t inlen, outlen, insize, outsize;
+  int check, done;
+  enum xz_ret ret;
+};
+
+static char *xz_msg(enum xz_ret ret)
+{
+  switch (ret) {
+  case XZ_MEM_ERROR:
+    return "Memory allocation failed";
+
+  case XZ_MEMLIMIT_ERROR:
+    return "Memory usage limit reached";
+
+  case XZ_FORMAT_ERROR:
+    return "Not a .xz file";
+
+  case XZ_OPTIONS_ERROR:
+    return "Unsupported options in the .xz headers";
+
+  case XZ_DATA_ERROR:
+  case XZ_BUF_ERROR:
+    return "File is corrupt";
 
-  while (size != 0) {
-    crc = xz_crc32_table[*buf++ ^ (crc & 0xFF)] ^ (crc >> 8);
-    --size;
+  default:
+    return "Bug!";
   }
+}
 
-  return ~crc;
+static void *xz_worker(void *arg)
+{
+  /*
+   * Support up to 64 MiB dictionary. The actually needed memory
+   * is allocated once the headers have been parsed.
+   */
+  struct xz_dec *s = xz_dec_init(1 << 26);
+  struct xzjob *job;
+  struct xz_buf b;
+
+  if (!s) error_exit("%s", xz_msg(XZ_MEM_ERROR));
+  for (;;) {
+    pthread_mutex_lock(&TT.mutex);
+    while (TT.taken == TT.submitted) pthread_cond_wait(&TT.cond, &TT.mutex);
+    job = TT.jobs+TT.taken++%(TT.threads+1);
+    pthread_mutex_unlock(&TT.mutex);
+
+    xz_dec_block(s, job->check);
+    b.in = job->in;
+    b.in_pos = 0;
+    b.in_size = job->inlen;
+    b.out = job->out;
+    b.out_pos = 0;
+    b.out_size = job->outlen;
+    job->ret = xz_dec_run(s, &b);
+    if (job->ret == XZ_UNSUPPORTED_CHECK) job->ret = xz_dec_run(s, &b);
+    if (job->ret == XZ_STREAM_END && b.out_pos != job->outlen)
+      job->ret = XZ_DATA_ERROR;
+
+    pthread_mutex_lock(&TT.mutex);
+    job->done = 1;
+    pthread_cond_broadcast(&TT.cond);
+    pthread_mutex_unlock(&TT.mutex);
+  }
+
+  return 0;
 }
 
-static uint64_t xz_crc64_table[256];
+// Wait for job to finish and write its output
+static void xz_collect(struct xzjob *job)
+{
+  pthread_mutex_lock(&TT.mutex);
+  while (!job->done) pthread_cond_wait(&TT.cond, &TT.mutex);
+  pthread_mutex_unlock(&TT.mutex);
 
+  if (job->ret != XZ_STREAM_END) error_exit("%s", xz_msg(job->ret));
+  xwrite(1, job->out, job->outlen);
+}
 
-// END xz.h
+// Decode variable length integer, returning nonzero if it doesn't fit.
+static int xz_vli(uint8_t *buf, size_t *pos, size_t size, uint64_t *vli)
+{
+  int shift;
+
+  for (*vli = shift = 0; *pos < size && shift < 63; shift += 7) {
+    uint8_t c = buf[(*pos)++];
+
+    *vli |= (uint64_t)(c&0x7f)<<shift;
+    if (!(c&0x80)) return 0;
+  }
+
+  return 1;
+}
+
+// If fd is a seekable file holding one Stream with several Blocks, find them
+// through the Index (which the Stream Footer says how to find) and decode
+// them on the worker threads, writing output in order. Returns nonzero if we
+// didn't, having only used pread() so the caller can still stream the file.
+// Jobs go in ring slots by TT.submitted, which carries on across files, so
+// workers taking them in that order find the same slots.
+static int xz_parallel(int fd)
+{
+  uint8_t head[12], foot[12], *index;
+  struct stat st;
+  struct xzjob *job;
+  uint64_t count, unpadded, uncompressed, off = 12, blocks[2], inflight = 0;
+  size_t len, pos = 1;
+  long seq, first, base = TT.submitted, ring = TT.threads+1;
+
+  if (fstat(fd, &st) || !S_ISREG(st.st_mode) || st.st_size < 36) return 1;
+  if (12 != pread(fd, head, 12, 0) || 12 != pread(fd, foot, 12, st.st_size-12))
+    return 1;
+  if (memcmp(head, "\3757zXZ", 6) || memcmp(foot+10, "YZ", 2)
+    || head[6] || head[7] > 15 || xz_crc32(head+6, 2, 0) != peek_le(head+8, 4)
+    || memcmp(head+6, foot+8, 2) || xz_crc32(foot+4, 6, 0) != peek_le(foot, 4))
+    return 1;
+  len = (peek_le(foot+4, 4)+1)*4;
+  if (len > st.st_size-24) return 1;
+
+  // Index: indicator, record count, then (unpadded, uncompressed) records
+  index = xmalloc(len);
+  if (len != pread(fd, index, len, st.st_size-12-len) || *index
+    || xz_crc32(index, len-4, 0) != peek_le(index+len-4, 4)
+    || xz_vli(index, &pos, len-4, &count) || count < 2)
+  {
+    free(index);
+
+    return 1;
+  }
+
+  // Check that blocks add up to the space before the index, and that none
+  // is too big to want in memory at once.
+  for (blocks[0] = pos, seq = 0; seq < count; seq++) {
+    if (xz_vli(index, &pos, len-4, &unpadded)
+      || xz_vli(index, &pos, len-4, &uncompressed)
+      || uncompressed > XZ_BLOCKMAX) break;
+    off += (unpadded+3)&~3;
+  }
+  if (seq != count || off != st.st_size-12-len) {
+    free(index);
+
+    return 1;
+  }
+
+  for (off = 12, pos = blocks[0], seq = first = 0; seq < count; seq++) {
+    xz_vli(index, &pos, len-4, &unpadded);
+    xz_vli(index, &pos, len-4, &uncompressed);
+    blocks[1] = (unpadded+3)&~3;
+
+    // Write out finished blocks until there's a free job and room for this one
+    while (first < seq
+      && (seq-first >= ring || inflight+blocks[1]+uncompressed > XZ_INFLIGHT))
+    {
+      job = TT.jobs+(base+first++)%ring;
+      inflight -= job->inlen+job->outlen;
+      xz_collect(job);
+    }
+    inflight += blocks[1]+uncompressed;
+
+    job = TT.jobs+(base+seq)%ring;
+    if (job->insize < blocks[1])
+      job->in = xrealloc(job->in, job->insize = blocks[1]);
+    if (job->outsize < uncompressed)
+      job->out = xrealloc(job->out, job->outsize = uncompressed);
+    if (blocks[1] != pread(fd, job->in, blocks[1], off)) perror_exit("read");
+    job->inlen = blocks[1];
+    job->outlen = uncompressed;
+    job->check = head[7];
+    job->done = 0;
+    off += blocks[1];
+
+    pthread_mutex_lock(&TT.mutex);
+    TT.submitted++;
+    pthread_cond_broadcast(&TT.cond);
+    pthread_mutex_unlock(&TT.mutex);
+  }
+  while (first < count) xz_collect(TT.jobs+(base+first++)%ring);
+  free(index);
 
-static uint8_t in[BUFSIZ];
-static uint8_t out[BUFSIZ];
+  return 0;
+}
 
 void do_xzcat(int fd, char *name)
 {
   struct xz_buf b;
   struct xz_dec *s;
   enum xz_ret ret;
-  const char *msg;
-
-  crc_init(xz_crc32_table, 1);
-  const uint64_t poly = 0xC96C5795D7870F42ULL;
-  uint32_t i;
-  uint32_t j;
-  uint64_t r;
-
-  /* initialize CRC64 table*/
-  for (i = 0; i < 256; ++i) {
-    r = i;
-    for (j = 0; j < 8; ++j)
-      r = (r >> 1) ^ (poly & ~((r & 1) - 1));
+  uint8_t *in, *out;
 
-    xz_crc64_table[i] = r;
-  }
+  if (TT.threads > 1 && !xz_parallel(fd)) return;
 
   /*
    * Support up to 64 MiB dictionary. The actually needed memory
    * is allocated once the headers have been parsed.
    */
   s = xz_dec_init(1 << 26);
-  if (s == NULL) {
-    msg = "Memory allocation failed\n";
-    goto error;
-  }
+  if (s == NULL) error_exit("%s", xz_msg(XZ_MEM_ERROR));
 
-  b.in = in;
+  b.in = in = xmalloc(XZ_IOBUF);
   b.in_pos = 0;
   b.in_size = 0;
-  b.out = out;
+  b.out = out = xmalloc(XZ_IOBUF);
   b.out_pos = 0;
-  b.out_size = BUFSIZ;
+  b.out_size = XZ_IOBUF;
 
   for (;;) {
     if (b.in_pos == b.in_size) {
-      b.in_size = read(fd, in, sizeof(in));
+      b.in_size = read(fd, in, XZ_IOBUF);
       b.in_pos = 0;
     }
 
     ret = xz_dec_run(s, &b);
 
-    if (b.out_pos == sizeof(out)) {
-      if (fwrite(out, 1, b.out_pos, stdout) != b.out_pos) {
-        msg = "Write error\n";
-        goto error;
-      }
-
+    if (b.out_pos == XZ_IOBUF) {
+      xwrite(1, out, b.out_pos);
       b.out_pos = 0;
     }
 
-    if (ret == XZ_OK)
-      continue;
-
-    if (ret == XZ_UNSUPPORTED_CHECK)
-      continue;
+    if (ret == XZ_OK || ret == XZ_UNSUPPORTED_CHECK) continue;
 
-    if (fwrite(out, 1, b.out_pos, stdout) != b.out_pos) {
-      msg = "Write error\n";
-      goto error;
-    }
+    xwrite(1, out, b.out_pos);
+    xz_dec_end(s);
+    free(in);
+    free(out);
+    if (ret != XZ_STREAM_END) error_exit("%s", xz_msg(ret));
 
-    switch (ret) {
-    case XZ_STREAM_END:
-      xz_dec_end(s);
-      return;
+    return;
+  }
+}
 
-    case XZ_MEM_ERROR:
-      msg = "Memory allocation failed\n";
-      goto error;
+void xzcat_main(void)
+{
+  const uint64_t poly = 0xC96C5795D7870F42ULL;
+  uint32_t i;
+  uint32_t j;
+  uint64_t r;
 
-    case XZ_MEMLIMIT_ERROR:
-      msg = "Memory usage limit reached\n";
-      goto error;
+  crc32_init(xz_crc32_table, 1);
 
-    case XZ_FORMAT_ERROR:
-      msg = "Not a .xz file\n";
-      goto error;
+  /* initialize CRC64 table*/
+  for (i = 0; i < 256; ++i) {
+    r = i;
+    for (j = 0; j < 8; ++j)
+      r = (r >> 1) ^ (poly & ~((r & 1) - 1));
 
-    case XZ_OPTIONS_ERROR:
-      msg = "Unsupported options in the .xz headers\n";
-      goto error;
+    xz_crc64_table[i] = r;
+  }
 
-    case XZ_DATA_ERROR:
-    case XZ_BUF_ERROR:
-      msg = "File is corrupt\n";
-      goto error;
+  // Start block decoding threads if we have the processors for it
+  TT.threads = sysconf(_SC_NPROCESSORS_ONLN);
+  if (TT.threads > 8) TT.threads = 8;
+  if (TT.threads > 1) {
+    pthread_t thread;
 
-    default:
-      msg = "Bug!\n";
-      goto error;
-    }
+    TT.jobs = xzalloc((TT.threads+1)*sizeof(struct xzjob));
+    pthread_mutex_init(&TT.mutex, 0);
+    pthread_cond_init(&TT.cond, 0);
+    for (i = 0; i<TT.threads; i++) xpthread_create(&thread, xz_worker, 0);
   }
 
-error:
-  xz_dec_end(s);
-  error_exit("%s", msg);
-}
-
-void xzcat_main(void)
-{
   loopfiles(toys.optargs, do_xzcat);
 }
 
@@ -2470,6 +2645,9 @@ struct xz_dec {
   struct xz_dec_bcj *bcj;
   int bcj_active;
 #endif
+
+  /* Stop after one Block, see xz_dec_block() */
+  int one_block;
 };
 
 /* Sizes of the Check field with different Check IDs */
@@ -2578,15 +2756,17 @@ static enum xz_ret dec_block(struct xz_dec *s, struct xz_buf *b)
   if (s->check_type == XZ_CHECK_CRC32)
     s->crc = xz_crc32(b->out + s->out_start,
         b->out_pos - s->out_start, s->crc);
-  else if (s->check_type == XZ_CHECK_CRC64)
-    s->crc = ~(s->crc);
+  else if (s->check_type == XZ_CHECK_CRC64) {
     size_t size = b->out_pos - s->out_start;
     uint8_t *buf = b->out + s->out_start;
+
+    s->crc = ~(s->crc);
     while (size) {
       s->crc = xz_crc64_table[*buf++ ^ (s->crc & 0xFF)] ^ (s->crc >> 8);
       --size;
     }
     s->crc=~(s->crc);
+  }
 
   if (ret == XZ_STREAM_END) {
     if (s->block_header.compressed != VLI_UNKNOWN
@@ -2991,6 +3171,9 @@ static enum xz_ret dec_main(struct xz_dec *s, struct xz_buf *b)
         return XZ_OK;
       }
 
+      if (s->one_block)
+        return XZ_STREAM_END;
+
       s->sequence = SEQ_BLOCK_START;
       break;
 
@@ -3127,6 +3310,15 @@ void xz_dec_reset(struct xz_dec *s)
   memset(&s->index, 0, sizeof(s->index));
   s->temp.pos = 0;
   s->temp.size = STREAM_HEADER_SIZE;
+  s->one_block = 0;
+}
+
+void xz_dec_block(struct xz_dec *s, int check_type)
+{
+  xz_dec_reset(s);
+  s->sequence = SEQ_BLOCK_START;
+  s->check_type = check_type;
+  s->one_block = 1;
 }
 
 void xz_dec_end(struct xz_dec *s)
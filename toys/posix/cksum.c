@@ -26,45 +26,42 @@ config CKSUM
 #include "toys.h"
 
 GLOBALS(
-  unsigned crc_table[256];
+  unsigned crc_table[8*256];
+  unsigned crc;
+  uint64_t llen;
+  unsigned (*cksum)(unsigned *table, unsigned crc, void *data, long len);
 )
 
-static unsigned cksum_be(unsigned crc, unsigned char c)
+// Callback for loopchunks()
+static void cksum_chunk(char *data, long len)
 {
-  return (crc<<8)^TT.crc_table[(crc>>24)^c];
-}
-
-static unsigned cksum_le(unsigned crc, unsigned char c)
-{
-  return TT.crc_table[(crc^c)&0xff] ^ (crc>>8);
+  TT.llen += len;
+  TT.crc = TT.cksum(TT.crc_table, TT.crc, data, len);
 }
 
 static void do_cksum(int fd, char *name)
 {
-  unsigned crc = (toys.optflags & FLAG_P) ? 0xffffffff : 0;
-  uint64_t llen = 0, llen2;
-  unsigned (*cksum)(unsigned crc, unsigned char c);
+  unsigned crc;
+  uint64_t llen, llen2;
+  unsigned (*cksum)(unsigned *table, unsigned crc, void *data, long len);
 
-  cksum = (toys.optflags & FLAG_L) ? cksum_le : cksum_be;
+  TT.cksum = cksum = (toys.optflags & FLAG_L) ? crc32_le : crc32_be;
   // CRC the data
 
-  for (;;) {
-    int len, i;
-
-    len = read(fd, toybuf, sizeof(toybuf));
-    if (len<0) perror_msg_raw(name);
-    if (len<1) break;
-
-    llen += len;
-    for (i=0; i<len; i++) crc=cksum(crc, toybuf[i]);
-  }
+  TT.crc = (toys.optflags & FLAG_P) ? 0xffffffff : 0;
+  TT.llen = 0;
+  loopchunks(fd, name, cksum_chunk);
+  crc = TT.crc;
+  llen = TT.llen;
 
   // CRC the length
 
   llen2 = llen;
   if (!(toys.optflags & FLAG_N)) {
     while (llen) {
-      crc = cksum(crc, llen);
+      char c = llen;
+
+      crc = cksum(TT.crc_table, crc, &c, 1);
       llen >>= 8;
     }
   }
@@ -78,6 +75,6 @@ static void do_cksum(int fd, char *name)
 
 void cksum_main(void)
 {
-  crc_init(TT.crc_table, toys.optflags & FLAG_L);
+  crc32_init(TT.crc_table, toys.optflags & FLAG_L);
   loopfiles(toys.optargs, do_cksum);
 }
@@ -12,7 +12,7 @@
 // options shared between mv/cp must be in same order (right to left)
 // for FLAG macros to work out right in shared infrastructure.
 
-USE_CP(NEWTOY(cp, "<2"USE_CP_PRESERVE("(preserve):;")"RHLPp"USE_CP_MORE("rdaslvnF(remove-destination)")"fi[-HLP"USE_CP_MORE("d")"]"USE_CP_MORE("[-ni]"), TOYFLAG_BIN))
+USE_CP(NEWTOY(cp, "<2"USE_CP_PRESERVE("(preserve):;")USE_CP_MORE("(reflink):;j#<1")"RHLPp"USE_CP_MORE("rdaslvnF(remove-destination)")"fi[-HLP"USE_CP_MORE("d")"]"USE_CP_MORE("[-ni]"), TOYFLAG_BIN))
 USE_MV(NEWTOY(mv, "<2"USE_CP_MORE("vnF")"fi"USE_CP_MORE("[-ni]"), TOYFLAG_BIN))
 USE_INSTALL(NEWTOY(install, "<1cdDpsvm:o:g:", TOYFLAG_USR|TOYFLAG_BIN))
 
@@ -39,15 +39,17 @@ config CP_MORE
   default y
   depends on CP
   help
-    usage: cp [-adlnrsv]
+    usage: cp [-adlnrsv] [-j N] [--reflink=auto|always|never]
 
     -a	same as -dpr
     -d	don't dereference symlinks
+    -j	copy contents of up to N files at once
     -l	hard link instead of copy
     -n	no clobber (don't overwrite DEST)
     -r	synonym for -R
     -s	symlink instead of copy
     -v	verbose
+    --reflink	share data blocks with source where filesystem can (default auto)
 
 config CP_PRESERVE
   bool "cp --preserve support"
@@ -120,6 +122,8 @@ GLOBALS(
       char *mode;
     } i;
     struct {
+      long j;
+      char *reflink;
       char *preserve;
     } c;
   };
@@ -129,15 +133,155 @@ GLOBALS(
   int (*callback)(struct dirtree *try);
   uid_t uid;
   gid_t gid;
-  int pflags;
+  int pflags, reflink;
+
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+  struct cp_job *jobs;
+  long threads, queued, done;
 )
 
+// File contents copy handed off to a -j worker thread. The dirtree node is
+// a copy with the whole path as its name.
+struct cp_job {
+  struct cp_job *next;
+  int fdin, fdout;
+  char *catch;
+  struct dirtree *try;
+};
+
 struct cp_preserve {
   char *name;
 } static const cp_preserve[] = TAGGED_ARRAY(CP,
   {"mode"}, {"ownership"}, {"timestamps"}, {"context"}, {"xattr"},
 );
 
+// Copy contents (and xattrs) of file fdin to fdout, closing fdin.
+
+static void cp_contents(int fdin, int fdout, char *catch)
+{
+  if (xcopyfile(fdin, fdout, TT.reflink)) perror_msg("reflink '%s'", catch);
+
+  // We only copy xattrs for files because there's no flistxattrat()
+  if (TT.pflags&(_CP_xattr|_CP_context)) {
+    ssize_t listlen = flistxattr(fdin, 0, 0), len;
+    char *name, *value, *list;
+
+    if (listlen>0) {
+      list = xmalloc(listlen);
+      flistxattr(fdin, list, listlen);
+      list[listlen-1] = 0; // I do not trust this API.
+      for (name = list; name-list < listlen; name += strlen(name)+1) {
+        if (!(TT.pflags&_CP_xattr) && strncmp(name, "security.", 9))
+          continue;
+        if ((len = fgetxattr(fdin, name, 0, 0))>0) {
+          value = xmalloc(len);
+          if (len == fgetxattr(fdin, name, value, len))
+            if (fsetxattr(fdout, name, value, len, 0))
+              perror_msg("%s setxattr(%s=%s)", catch, name, value);
+          free(value);
+        }
+      }
+      free(list);
+    }
+  }
+
+  close(fdin);
+}
+
+// Set --preserve attributes of what we made, closing fdout. (If we couldn't
+// get a filehandle to the actual object, fdout is AT_FDCWD and we use racy
+// functions on catch in cfd.)
+
+static void cp_fixup(struct dirtree *try, int fdout, int cfd, char *catch)
+{
+  int rc;
+
+  // Inability to set --preserve isn't fatal, some require root access.
+
+  // ownership
+  if (TT.pflags & _CP_ownership) {
+
+    // permission bits already correct for mknod and don't apply to symlink
+    if (fdout == AT_FDCWD)
+      rc = fchownat(cfd, catch, try->st.st_uid, try->st.st_gid,
+                    AT_SYMLINK_NOFOLLOW);
+    else rc = fchown(fdout, try->st.st_uid, try->st.st_gid);
+    if (rc) {
+      char *pp;
+
+      perror_msg("chown '%s'", pp = dirtree_path(try, 0));
+      free(pp);
+    }
+  }
+
+  // timestamp
+  if (TT.pflags & _CP_timestamps) {
+    struct timespec times[] = {try->st.st_atim, try->st.st_mtim};
+
+    if (fdout == AT_FDCWD) utimensat(cfd, catch, times, AT_SYMLINK_NOFOLLOW);
+    else futimens(fdout, times);
+  }
+
+  // mode comes last because other syscalls can strip suid bit
+  if (fdout != AT_FDCWD) {
+    if (TT.pflags & _CP_mode) fchmod(fdout, try->st.st_mode);
+    xclose(fdout);
+  }
+}
+
+// cp -j: worker threads finish file copies cp_node() opened.
+
+static void *cp_worker(void *arg)
+{
+  struct cp_job *job;
+
+  for (;;) {
+    pthread_mutex_lock(&TT.mutex);
+    while (!(job = TT.jobs) && !TT.done) pthread_cond_wait(&TT.cond, &TT.mutex);
+    if (job) {
+      TT.jobs = job->next;
+      TT.queued--;
+      pthread_cond_broadcast(&TT.cond);
+    }
+    pthread_mutex_unlock(&TT.mutex);
+    if (!job) return 0;
+
+    cp_contents(job->fdin, job->fdout, job->catch);
+    cp_fixup(job->try, job->fdout, AT_FDCWD, job->catch);
+    free(job->try);
+    free(job);
+  }
+}
+
+// Queue a copy, waiting if too many (each holds two filehandles) are queued.
+
+static void cp_queue(struct dirtree *try, int fdin, int fdout, char *catch)
+{
+  struct cp_job *job, **last;
+  char *path = dirtree_path(try, 0);
+  int len = strlen(path)+1;
+
+  job = xmalloc(sizeof(struct cp_job)+strlen(catch)+1);
+  job->next = 0;
+  job->fdin = fdin;
+  job->fdout = fdout;
+  job->catch = strcpy((char *)(job+1), catch);
+  job->try = xmalloc(sizeof(struct dirtree)+len);
+  memcpy(job->try, try, sizeof(struct dirtree));
+  job->try->parent = 0;
+  memcpy(job->try->name, path, len);
+  free(path);
+
+  pthread_mutex_lock(&TT.mutex);
+  while (TT.queued >= 2*TT.threads) pthread_cond_wait(&TT.cond, &TT.mutex);
+  for (last = &TT.jobs; *last; last = &(*last)->next);
+  *last = job;
+  TT.queued++;
+  pthread_cond_broadcast(&TT.cond);
+  pthread_mutex_unlock(&TT.mutex);
+}
+
 // Callback from dirtree_read() for each file/directory under a source dir.
 
 int cp_node(struct dirtree *try)
@@ -286,76 +430,22 @@ int cp_node(struct dirtree *try)
           break;
         }
         fdout = openat(cfd, catch, O_RDWR|O_CREAT|O_TRUNC, try->st.st_mode);
-        if (fdout >= 0) {
-          xsendfile(fdin, fdout);
-          err = 0;
-        }
+        if (fdout < 0) close(fdin);
+        else if (TT.threads) {
+          cp_queue(try, fdin, fdout, catch);
 
-        // We only copy xattrs for files because there's no flistxattrat()
-        if (TT.pflags&(_CP_xattr|_CP_context)) {
-          ssize_t listlen = flistxattr(fdin, 0, 0), len;
-          char *name, *value, *list;
-
-          if (listlen>0) {
-            list = xmalloc(listlen);
-            flistxattr(fdin, list, listlen);
-            list[listlen-1] = 0; // I do not trust this API.
-            for (name = list; name-list < listlen; name += strlen(name)+1) {
-              if (!(TT.pflags&_CP_xattr) && strncmp(name, "security.", 9))
-                continue;
-              if ((len = fgetxattr(fdin, name, 0, 0))>0) {
-                value = xmalloc(len);
-                if (len == fgetxattr(fdin, name, value, len))
-                  if (fsetxattr(fdout, name, value, len, 0))
-                    perror_msg("%s setxattr(%s=%s)", catch, name, value);
-                free(value);
-              }
-            }
-            free(list);
-          }
+          return 0;
+        } else {
+          cp_contents(fdin, fdout, catch);
+          err = 0;
         }
-
-        close(fdin);
       }
     } while (err && (flags & (FLAG_f|FLAG_n)) && !unlinkat(cfd, catch, 0));
   }
 
   // Did we make a thing?
   if (fdout != -1) {
-    int rc;
-
-    // Inability to set --preserve isn't fatal, some require root access.
-
-    // ownership
-    if (TT.pflags & _CP_ownership) {
-
-      // permission bits already correct for mknod and don't apply to symlink
-      // If we can't get a filehandle to the actual object, use racy functions
-      if (fdout == AT_FDCWD)
-        rc = fchownat(cfd, catch, try->st.st_uid, try->st.st_gid,
-                      AT_SYMLINK_NOFOLLOW);
-      else rc = fchown(fdout, try->st.st_uid, try->st.st_gid);
-      if (rc) {
-        char *pp;
-
-        perror_msg("chown '%s'", pp = dirtree_path(try, 0));
-        free(pp);
-      }
-    }
-
-    // timestamp
-    if (TT.pflags & _CP_timestamps) {
-      struct timespec times[] = {try->st.st_atim, try->st.st_mtim};
-
-      if (fdout == AT_FDCWD) utimensat(cfd, catch, times, AT_SYMLINK_NOFOLLOW);
-      else futimens(fdout, times);
-    }
-
-    // mode comes last because other syscalls can strip suid bit
-    if (fdout != AT_FDCWD) {
-      if (TT.pflags & _CP_mode) fchmod(fdout, try->st.st_mode);
-      xclose(fdout);
-    }
+    cp_fixup(try, fdout, cfd, catch);
 
     if (CFG_MV && toys.which->name[0] == 'm')
       if (unlinkat(tfd, try->name, S_ISDIR(try->st.st_mode) ? AT_REMOVEDIR :0))
@@ -369,6 +459,7 @@ int cp_node(struct dirtree *try)
 void cp_main(void)
 {
   char *destname = toys.optargs[--toys.optc];
+  pthread_t *threads = 0;
   int i, destdir = !stat(destname, &TT.top) && S_ISDIR(TT.top.st_mode);
 
   if (toys.optc>1 && !destdir) error_exit("'%s' not directory", destname);
@@ -400,7 +491,22 @@ void cp_main(void)
     }
     free(pre);
   }
+  TT.reflink = 1;
+  if (CFG_CP_MORE && (toys.optflags & FLAG_reflink)) {
+    char *s = TT.c.reflink;
+
+    if (!s || !strcmp(s, "always")) TT.reflink = 2;
+    else if (!strcmp(s, "never")) TT.reflink = 0;
+    else if (strcmp(s, "auto")) error_exit("bad --reflink=%s", s);
+  }
   if (!TT.callback) TT.callback = cp_node;
+  if (CFG_CP_MORE && (toys.optflags & FLAG_j) && TT.c.j>1) {
+    threads = xmalloc(TT.c.j*sizeof(pthread_t));
+    pthread_mutex_init(&TT.mutex, 0);
+    pthread_cond_init(&TT.cond, 0);
+    for (TT.threads = 0; TT.threads<TT.c.j; TT.threads++)
+      xpthread_create(threads+TT.threads, cp_worker, 0);
+  }
 
   // Loop through sources
   for (i=0; i<toys.optc; i++) {
@@ -438,6 +544,16 @@ void cp_main(void)
     }
     if (destdir) free(TT.destname);
   }
+
+  // Wait for -j workers to finish
+  if (threads) {
+    pthread_mutex_lock(&TT.mutex);
+    TT.done = 1;
+    pthread_cond_broadcast(&TT.cond);
+    pthread_mutex_unlock(&TT.mutex);
+    for (i = 0; i<TT.threads; i++) pthread_join(threads[i], 0);
+    if (CFG_TOYBOX_FREE) free(threads);
+  }
 }
 
 void mv_main(void)
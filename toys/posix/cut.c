@@ -126,6 +126,7 @@ static void get_data(void)
 // perform cut operation on the given delimiter.
 static void do_fcut(int fd)
 {
+  struct linebuf *lb = linebuf_new(fd);
   char *buff, *pfield = 0, *delimiter = TT.delim;
 
   for (;;) {
@@ -133,11 +134,13 @@ static void do_fcut(int fd)
     int start, ndelimiters = -1;
     int  nprinted_fields = 0;
     struct slist *temp_node = TT.slist_head;
+    long len;
 
     free(pfield);
     pfield = 0;
 
-    if (!(buff = get_line(fd))) break;
+    if (!(buff = linebuf_view(lb, &len, '\n'))) break;
+    if (buff[len-1] == '\n') buff[len-1] = 0;
 
     //does line have any delimiter?.
     if (strrchr(buff, (int)delimiter[0]) == NULL) {
@@ -182,19 +185,25 @@ static void do_fcut(int fd)
     }
     xputc('\n');
   }
+  linebuf_free(lb);
 }
 
 // perform cut operation char or byte.
 static void do_bccut(int fd)
 {
+  struct linebuf *lb = linebuf_new(fd);
   char *buff;
+  long len;
 
-  while ((buff = get_line(fd)) != NULL) {
+  while ((buff = linebuf_view(lb, &len, '\n')) != NULL) {
     unsigned cpos = 0;
-    int buffln = strlen(buff);
-    char *pfield = xzalloc(buffln + 1);
+    int buffln;
+    char *pfield;
     struct slist *temp_node = TT.slist_head;
 
+    if (buff[len-1] == '\n') buff[len-1] = 0;
+    pfield = xzalloc((buffln = strlen(buff)) + 1);
+
     if (temp_node != NULL) {
       while (cpos < TT.nelem) {
         int start;
@@ -224,6 +233,7 @@ static void do_bccut(int fd)
     free(pfield);
     pfield = NULL;
   }
+  linebuf_free(lb);
 }
 
 void cut_main(void)
@@ -41,7 +41,7 @@ GLOBALS(
 
   long depth, total;
   dev_t st_dev;
-  void *inodes;
+  struct inoset inodes;
 )
 
 typedef struct node_size {
@@ -72,35 +72,15 @@ static void print(long long size, struct dirtree *node)
   if (node) free(name);
 }
 
-// Return whether or not we've seen this inode+dev, adding it to the list if
+// Return whether or not we've seen this inode+dev, adding it to the set if
 // we haven't.
-static int seen_inode(void **list, struct stat *st)
+static int seen_inode(struct inoset *set, struct stat *st)
 {
-  if (!st) llist_traverse(st, free);
-
   // Skipping dir nodes isn't _quite_ right. They're not hardlinked, but could
   // be bind mounted. Still, it's more efficient and the archivers can't use
   // hardlinked directory info anyway. (Note that we don't catch bind mounted
   // _files_ because it doesn't change st_nlink.)
-  else if (!S_ISDIR(st->st_mode) && st->st_nlink > 1) {
-    struct inode_list {
-      struct inode_list *next;
-      ino_t ino;
-      dev_t dev;
-    } *new;
-
-    for (new = *list; new; new = new->next)
-      if(new->ino == st->st_ino && new->dev == st->st_dev)
-        return 1;
-
-    new = xzalloc(sizeof(*new));
-    new->ino = st->st_ino;
-    new->dev = st->st_dev;
-    new->next = *list;
-    *list = new;
-  }
-
-  return 0;
+  return !S_ISDIR(st->st_mode) && st->st_nlink>1 && inoset_add(set, st, 0);
 }
 
 // dirtree callback, comput/display size of node
@@ -130,7 +110,9 @@ static int do_du(struct dirtree *node)
   if (S_ISDIR(node->st.st_mode)) {
     if (!node->again) {
       TT.depth++;
-      return DIRTREE_COMEAGAIN|(DIRTREE_SYMFOLLOW*!!(toys.optflags&FLAG_L));
+      return DIRTREE_COMEAGAIN|DIRTREE_PARALLEL
+        |(DIRTREE_SYMFOLLOW*!!(toys.optflags&FLAG_L))
+        |(DIRTREE_NOAHEAD*!!(toys.optflags&FLAG_x));
     } else TT.depth--;
   }
 
@@ -157,5 +139,5 @@ void du_main(void)
       do_du);
   if (toys.optflags & FLAG_c) print(TT.total*512, 0);
 
-  if (CFG_TOYBOX_FREE) seen_inode(TT.inodes, 0);
+  if (CFG_TOYBOX_FREE) inoset_free(&TT.inodes, 0);
 }
@@ -10,18 +10,19 @@
  *
  * TODO: -empty (dirs too!)
 
-USE_FIND(NEWTOY(find, "?^HL[-HL]", TOYFLAG_USR|TOYFLAG_BIN))
+USE_FIND(NEWTOY(find, "?^HLj#<1[-HL]", TOYFLAG_USR|TOYFLAG_BIN))
 
 config FIND
   bool "find"
   default y
   help
-    usage: find [-HL] [DIR...] [<options>]
+    usage: find [-HL] [-j N] [DIR...] [<options>]
 
     Search directories for matching files.
     Default: search "." match all -print all matches.
 
     -H  Follow command line symlinks         -L  Follow all symlinks
+    -j  Run up to N "-exec {} +" commands at once while still searching
 
     Match filters:
     -name  PATTERN  filename with wildcards   -iname      case insensitive -name
@@ -56,9 +57,12 @@ config FIND
 #include "toys.h"
 
 GLOBALS(
+  long j;
+
   char **filter;
   struct double_list *argdata;
-  int topdir, xdev, depth;
+  int topdir, xdev, depth, parallel, running;
+  long max_bytes;
   time_t now;
 )
 
@@ -66,6 +70,7 @@ struct execdir_data {
   struct execdir_data *next;
 
   int namecount;
+  long bytes;
   struct double_list *names;
 };
 
@@ -78,6 +83,13 @@ struct exec_range {
   struct execdir_data exec, *execdir;
 };
 
+// Reap one backgrounded "-exec +" command
+static void exec_reap(void)
+{
+  toys.exitval |= xwaitpid(-1);
+  TT.running--;
+}
+
 // Perform pending -exec (if any)
 static int flush_exec(struct dirtree *new, struct exec_range *aa)
 {
@@ -120,11 +132,20 @@ static int flush_exec(struct dirtree *new, struct exec_range *aa)
     newargs[pos+rest] = 0;
   }
 
-  rc = xrun(newargs);
+  // With -j leave "-exec +" running while we search, its exit code is
+  // collected by exec_reap()
+  if (aa->plus && TT.j) {
+    while (TT.running >= TT.j) exec_reap();
+    xpopen_both(newargs, 0);
+    TT.running++;
+    rc = 0;
+  } else rc = xrun(newargs);
+  free(newargs);
 
   llist_traverse(bb->names, llist_free_double);
   bb->names = 0;
   bb->namecount = 0;
+  bb->bytes = 0;
 
   if (revert) revert = fchdir(TT.topdir);
 
@@ -191,6 +212,20 @@ static void execdir(struct dirtree *new, int flush)
   }
 } 
 
+// Does this test look at more than the file type? (dirtree doesn't stat
+// files for us, only directories and symlinks.)
+static int needstat(char *s)
+{
+  char *tests[] = {"nouser", "nogroup", "perm", "atime", "ctime", "mtime",
+    "size", "links", "inum", "user", "group", "newer"};
+  int i;
+
+  for (i = 0; i<sizeof(tests)/sizeof(*tests); i++)
+    if (!strcmp(s, tests[i])) return 1;
+
+  return 0;
+}
+
 // Call this with 0 for first pass argument parsing and syntax checking (which
 // populates argdata). Later commands traverse argdata (in order) when they
 // need "do once" results.
@@ -200,7 +235,8 @@ static int do_find(struct dirtree *new)
   struct double_list *argdata = TT.argdata;
   char *s, **ss;
 
-  recurse = DIRTREE_COMEAGAIN|(DIRTREE_SYMFOLLOW*!!(toys.optflags&FLAG_L));
+  recurse = DIRTREE_COMEAGAIN|(DIRTREE_SYMFOLLOW*!!(toys.optflags&FLAG_L))
+    |TT.parallel|DIRTREE_STATLESS;
 
   // skip . and .. below topdir, handle -xdev and -depth
   if (new) {
@@ -277,6 +313,13 @@ static int do_find(struct dirtree *new)
       continue;
     } else s++;
 
+    if (check && new->nostat && needstat(s) && dirtree_restat(new)) {
+      perror_msg("%s", s = dirtree_path(new, 0));
+      free(s);
+
+      return 0;
+    }
+
     if (!strcmp(s, "xdev")) TT.xdev = 1;
     else if (!strcmp(s, "delete")) {
       // Delete forces depth first
@@ -481,26 +524,28 @@ static int do_find(struct dirtree *new)
             }
           }
 
-          // Add next name to list (global list without -dir, local with)
+          // Global list without -dir, local with
           bb = aa->execdir ? aa->execdir : &aa->exec;
-          dlist_add(&bb->names, name);
-          bb->namecount++;
 
           // -exec + collates and saves result in exitval
           if (aa->plus) {
+            long len = sizeof(char *)+strlen(name)+1;
+
             // Mark entry so COMEAGAIN can call flush_exec() in parent.
             // This is never a valid pointer value for prev to have otherwise
             // Done here vs argument parsing pass so it's after dlist_terminate
             aa->prev = (void *)1;
 
-            // Flush if we pass 16 megs of environment space.
-            // An insanely long path (>2 gigs) could wrap the counter and
-            // defeat this test, which could potentially trigger OOM killer.
-            if ((aa->plus += sizeof(char *)+strlen(name)+1) > 1<<24) {
-              aa->plus = 1;
+            // Flush first if this name would take us past ARG_MAX.
+            if (bb->namecount && aa->argsize+bb->bytes+len > TT.max_bytes)
               toys.exitval |= flush_exec(new, aa);
-            }
-          } else test = flush_exec(new, aa);
+            bb->bytes += len;
+          }
+
+          // Add next name to list
+          dlist_add(&bb->names, name);
+          bb->namecount++;
+          if (!aa->plus) test = flush_exec(new, aa);
         }
 
         // Argument consumed, skip the check.
@@ -550,16 +595,32 @@ void find_main(void)
     len = 1;
   }
 
+  // Size "-exec +" batches to fit in ARG_MAX along with our environment.
+  TT.max_bytes = sysconf(_SC_ARG_MAX)-2048;
+  for (i = 0; environ[i]; i++)
+    TT.max_bytes -= sizeof(char *)+strlen(environ[i])+1;
+
   // first pass argument parsing, verify args match up, handle "evaluate once"
   TT.now = time(0);
   do_find(0);
 
+  // Read ahead with threads, unless actions could change the tree under us.
+  TT.parallel = DIRTREE_PARALLEL;
+  for (i = 0; TT.filter[i]; i++)
+    if (!strncmp(TT.filter[i], "-exec", 5) || !strncmp(TT.filter[i], "-ok", 3)
+      || !strcmp(TT.filter[i], "-delete")) TT.parallel = 0;
+  // Don't read ahead into directories we might not descend into.
+  for (i = 0; TT.parallel && TT.filter[i]; i++)
+    if (!strcmp(TT.filter[i], "-maxdepth") || !strcmp(TT.filter[i], "-prune")
+      || !strcmp(TT.filter[i], "-xdev")) TT.parallel |= DIRTREE_NOAHEAD;
+
   // Loop through paths
   for (i = 0; i < len; i++)
     dirtree_flagread(ss[i], DIRTREE_SYMFOLLOW*!!(toys.optflags&(FLAG_H|FLAG_L)),
       do_find);
 
   execdir(0, 1);
+  while (TT.running) exec_reap();
 
   if (CFG_TOYBOX_FREE) {
     close(TT.topdir);
@@ -6,7 +6,7 @@
  *
  * TODO: -ABC
 
-USE_GREP(NEWTOY(grep, "C#B#A#ZzEFHabhinorsvwclqe*f*m#x[!wx][!EFw]", TOYFLAG_BIN))
+USE_GREP(NEWTOY(grep, "j#<1C#B#A#IZzEFHabhinorsvwclqe*f*m#x[!wx][!EFw]", TOYFLAG_BIN))
 USE_EGREP(OLDTOY(egrep, grep, TOYFLAG_BIN))
 USE_FGREP(OLDTOY(fgrep, grep, TOYFLAG_BIN))
 
@@ -14,7 +14,7 @@ config GREP
   bool "grep"
   default y
   help
-    usage: grep [-EFivwcloqsHbhn] [-A NUM] [-m MAX] [-e REGEX]... [-f REGFILE] [FILE]...
+    usage: grep [-EFIivwcloqsHbhn] [-j NUM] [-A NUM] [-m MAX] [-e REGEX]... [-f REGFILE] [FILE]...
 
     Show lines matching regular expressions. If no -e, first argument is
     regular expression to match. With no files (or "-" filename) read stdin.
@@ -30,6 +30,7 @@ config GREP
     -m  match MAX many lines     -r  recursive (on dir)
     -v  invert match             -w  whole word (implies -E)
     -x  whole line               -z  input NUL terminated
+    -I  skip binary files        -j  search NUM files at once (with -r)
 
     display modes: (default: matched line)
     -c  count of matching lines  -l  show matching filenames
@@ -62,32 +63,157 @@ GLOBALS(
   long a;
   long b;
   long c;
-
-  char indelim, outdelim;
+  long j;
+
+  char indelim, outdelim, *regstr;
+  int cflags, threads, finish, acempty, *acroot;
+  struct acnode *ac;
+  long queued;
+  struct grep_job *jobs, **tail, *next;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
 )
 
+// -F patterns: Aho-Corasick trie with children in sibling lists (the root's
+// in acroot[]), fail links to the longest proper suffix also in the trie, and
+// dict links to the next suffix that ends a pattern.
+struct acnode {
+  int child, sibling, fail, dict, len, depth;
+  unsigned char c;
+};
+
+// grep -r -j: file searched by a worker thread, output saved until its turn.
+struct grep_job {
+  struct grep_job *next;
+  char *name, *out;
+  size_t len;
+  int fd, done;
+};
+
+static int ac_child(int n, unsigned char c)
+{
+  if (!n) return TT.acroot[c];
+  for (n = TT.ac[n].child; n; n = TT.ac[n].sibling) if (TT.ac[n].c == c) break;
+
+  return n;
+}
+
+// Build trie of -F patterns in one pass, then breadth first fail links.
+static void ac_build(void)
+{
+  struct arg_list *al;
+  int i, n, m, used = 1, size = 256, *queue;
+  unsigned char c, *s;
+
+  TT.ac = xzalloc(size*sizeof(struct acnode));
+  TT.acroot = xzalloc(256*sizeof(int));
+  for (al = TT.e; al; al = al->next) {
+    if (!*al->arg) TT.acempty++;
+    for (n = 0, s = (void *)al->arg; *s; s++) {
+      c = (toys.optflags & FLAG_i) ? tolower(*s) : *s;
+      if (!(m = ac_child(n, c))) {
+        if (used == size) {
+          TT.ac = xrealloc(TT.ac, (size *= 2)*sizeof(struct acnode));
+          memset(TT.ac+used, 0, (size-used)*sizeof(struct acnode));
+        }
+        m = used++;
+        TT.ac[m].c = c;
+        TT.ac[m].depth = TT.ac[n].depth+1;
+        if (n) {
+          TT.ac[m].sibling = TT.ac[n].child;
+          TT.ac[n].child = m;
+        } else TT.acroot[c] = m;
+      }
+      n = m;
+    }
+    if (n) TT.ac[n].len = TT.ac[n].depth;
+  }
+
+  // Children of the root fail to the root, everybody else follows the parent's
+  // fail chain to the longest suffix with a matching child.
+  queue = xmalloc(used*sizeof(int));
+  for (i = m = 0; i<256; i++) if (TT.acroot[i]) queue[m++] = TT.acroot[i];
+  for (i = 0; i<m; i++) {
+    for (n = TT.ac[queue[i]].child; n; n = TT.ac[n].sibling) {
+      int f = TT.ac[queue[i]].fail;
+
+      while (f && !ac_child(f, TT.ac[n].c)) f = TT.ac[f].fail;
+      f = TT.ac[n].fail = ac_child(f, TT.ac[n].c);
+      TT.ac[n].dict = TT.ac[f].len ? f : TT.ac[f].dict;
+      queue[m++] = n;
+    }
+  }
+  free(queue);
+}
+
+// Find leftmost-longest -F match in one pass over the line, returning 0 and
+// filling out match like regexec() does.
+static int ac_match(char *start, regmatch_t *match)
+{
+  long i, so = TT.acempty ? 0 : -1, eo = 0;
+  int n = 0, m;
+  unsigned char c;
+
+  for (i = 0; start[i]; i++) {
+    // Stop when no pattern in progress could start at or before best match.
+    if (so != -1 && i-TT.ac[n].depth > so) break;
+
+    c = start[i];
+    if (toys.optflags & FLAG_i) c = tolower(c);
+    while (n && !(m = ac_child(n, c))) n = TT.ac[n].fail;
+    n = n ? m : ac_child(0, c);
+
+    for (m = TT.ac[n].len ? n : TT.ac[n].dict; m; m = TT.ac[m].dict) {
+      long s = i+1-TT.ac[m].len;
+
+      if (so == -1 || s < so || (s == so && i+1 > eo)) {
+        so = s;
+        eo = i+1;
+      }
+    }
+  }
+  if (so == -1) return 1;
+  match->rm_so = so;
+  match->rm_eo = eo;
+
+  return 0;
+}
+
 // Emit line with various potential prefixes and delimiter
-static void outline(char *line, char dash, char *name, long lcount, long bcount,
-  int trim)
+static void outline(FILE *out, char *line, char dash, char *name, long lcount,
+  long bcount, int trim)
 {
-  if (name && (toys.optflags&FLAG_H)) printf("%s%c", name, dash);
+  if (name && (toys.optflags&FLAG_H)) fprintf(out, "%s%c", name, dash);
   if (!line || (lcount && (toys.optflags&FLAG_n)))
-    printf("%ld%c", lcount, line ? dash : TT.outdelim);
-  if (bcount && (toys.optflags&FLAG_b)) printf("%ld%c", bcount-1, dash);
-  if (line) xprintf("%.*s%c", trim ? trim : INT_MAX/2, line, TT.outdelim);
+    fprintf(out, "%ld%c", lcount, line ? dash : TT.outdelim);
+  if (bcount && (toys.optflags&FLAG_b)) fprintf(out, "%ld%c", bcount-1, dash);
+  if (line) fprintf(out, "%.*s%c", trim ? trim : INT_MAX/2, line, TT.outdelim);
+  if (out == stdout) xflush();
 }
 
-// Show matches in one file
-static void do_grep(int fd, char *name)
+// Show matches in one file, writing output to out and matching against reg
+static void grep_file(int fd, char *name, FILE *out, regex_t *reg)
 {
   struct double_list *dlb = 0;
-  FILE *file = fdopen(fd, "r");
+  FILE *file;
   long lcount = 0, mcount = 0, offset = 0, after = 0, before = 0;
   char *bars = 0;
 
   if (!fd) name = "(standard input)";
 
-  if (!file) {
+  // -I: skip files with a NUL byte in the first block
+  if (toys.optflags & FLAG_I) {
+    char buf[4096];
+    long len = pread(fd, buf, sizeof(buf), 0);
+
+    if (len > 0 && memchr(buf, 0, len)) {
+      if (fd) close(fd);
+
+      return;
+    }
+  }
+
+  if (!(file = fdopen(fd, "r"))) {
     perror_msg_raw(name);
     return;
   }
@@ -112,30 +238,10 @@ static void do_grep(int fd, char *name)
 
       // Handle non-regex matches
       if (toys.optflags & FLAG_F) {
-        struct arg_list *seek, fseek;
-        char *s = 0;
-
-        for (seek = TT.e; seek; seek = seek->next) {
-          if (toys.optflags & FLAG_x) {
-            int i = (toys.optflags & FLAG_i);
-
-            if ((i ? strcasecmp : strcmp)(seek->arg, line)) s = line;
-          } else if (!*seek->arg) {
-            seek = &fseek;
-            fseek.arg = s = line;
-            break;
-          }
-          if (toys.optflags & FLAG_i) s = strnstr(line, seek->arg);
-          else s = strstr(line, seek->arg);
-          if (s) break;
-        }
-
-        if (s) {
-          matches.rm_so = (s-line);
-          skip = matches.rm_eo = (s-line)+strlen(seek->arg);
-        } else rc = 1;
+        rc = ac_match(start, &matches);
+        skip = matches.rm_eo;
       } else {
-        rc = regexec((regex_t *)toybuf, start, 1, &matches,
+        rc = regexec(reg, start, 1, &matches,
                      start==line ? 0 : REG_NOTBOL);
         skip = matches.rm_eo;
       }
@@ -177,14 +283,15 @@ static void do_grep(int fd, char *name)
 
       // At least one line we didn't print since match while -ABC active
       if (bars) {
-        xputs(bars);
+        fprintf(out, "%s\n", bars);
         bars = 0;
       }
       mmatch++;
       toys.exitval = 0;
       if (toys.optflags & FLAG_q) xexit();
       if (toys.optflags & FLAG_l) {
-        xprintf("%s%c", name, TT.outdelim);
+        fprintf(out, "%s%c", name, TT.outdelim);
+        if (out == stdout) xflush();
         free(line);
         fclose(file);
         return;
@@ -201,15 +308,15 @@ static void do_grep(int fd, char *name)
           while (dlb) {
             struct double_list *dl = dlist_pop(&dlb);
 
-            outline(dl->data, '-', name, lcount-before, 0, 0);
+            outline(out, dl->data, '-', name, lcount-before, 0, 0);
             free(dl->data);
             free(dl);
             before--;
           }
 
-          outline(line, ':', name, lcount, bcount, 0);
+          outline(out, line, ':', name, lcount, bcount, 0);
           if (TT.a) after = TT.a+1;
-        } else outline(start+matches.rm_so, ':', name, lcount, bcount,
+        } else outline(out, start+matches.rm_so, ':', name, lcount, bcount,
                        matches.rm_eo-matches.rm_so);
       }
 
@@ -223,7 +330,7 @@ static void do_grep(int fd, char *name)
       int discard = (after || TT.b);
 
       if (after && --after) {
-        outline(line, '-', name, lcount, 0, 0);
+        outline(out, line, '-', name, lcount, 0, 0);
         discard = 0;
       }
       if (discard && TT.b) {
@@ -247,12 +354,92 @@ static void do_grep(int fd, char *name)
     if ((toys.optflags & FLAG_m) && mcount >= TT.m) break;
   }
 
-  if (toys.optflags & FLAG_c) outline(0, ':', name, mcount, 0, 0);
+  if (toys.optflags & FLAG_c) outline(out, 0, ':', name, mcount, 0, 0);
 
   // loopfiles will also close the fd, but this frees an (opaque) struct.
   fclose(file);
 }
 
+static void do_grep(int fd, char *name)
+{
+  grep_file(fd, name, stdout, (regex_t *)toybuf);
+}
+
+// Worker thread for grep -r -j, with its own regex because glibc's regexec()
+// serializes callers sharing one.
+
+static void *grep_worker(void *arg)
+{
+  struct grep_job *job;
+  regex_t reg;
+  FILE *out;
+
+  if (TT.regstr) regcomp(&reg, TT.regstr, TT.cflags);
+  for (;;) {
+    pthread_mutex_lock(&TT.mutex);
+    while (!(job = TT.next) && !TT.finish)
+      pthread_cond_wait(&TT.cond, &TT.mutex);
+    if (job) TT.next = job->next;
+    pthread_mutex_unlock(&TT.mutex);
+    if (!job) break;
+
+    if (!(out = open_memstream(&job->out, &job->len))) perror_exit(0);
+    grep_file(job->fd, job->name, out, &reg);
+    fclose(out);
+
+    pthread_mutex_lock(&TT.mutex);
+    job->done = 1;
+    pthread_cond_broadcast(&TT.cond);
+    pthread_mutex_unlock(&TT.mutex);
+  }
+  if (TT.regstr) regfree(&reg);
+
+  return 0;
+}
+
+// Write finished output in the order files were queued, waiting for workers
+// until no more than max jobs are outstanding.
+
+static void grep_emit(long max)
+{
+  struct grep_job *job;
+
+  for (;;) {
+    pthread_mutex_lock(&TT.mutex);
+    while ((job = TT.jobs) && !job->done && TT.queued > max)
+      pthread_cond_wait(&TT.cond, &TT.mutex);
+    if (job && job->done) {
+      if (!(TT.jobs = job->next)) TT.tail = &TT.jobs;
+      TT.queued--;
+    } else job = 0;
+    pthread_mutex_unlock(&TT.mutex);
+    if (!job) return;
+
+    fwrite(job->out, 1, job->len, stdout);
+    xflush();
+    free(job->out);
+    free(job->name);
+    free(job);
+  }
+}
+
+static void grep_queue(int fd, char *name)
+{
+  struct grep_job *job = xzalloc(sizeof(struct grep_job));
+
+  job->fd = fd;
+  job->name = name;
+  grep_emit(4*TT.threads-1);
+
+  pthread_mutex_lock(&TT.mutex);
+  *TT.tail = job;
+  TT.tail = &job->next;
+  if (!TT.next) TT.next = job;
+  TT.queued++;
+  pthread_cond_broadcast(&TT.cond);
+  pthread_mutex_unlock(&TT.mutex);
+}
+
 static void parse_regex(void)
 {
   struct arg_list *al, *new, *list = NULL;
@@ -286,7 +473,16 @@ static void parse_regex(void)
   }
   TT.e = list;
 
+  // Regexes without special characters are literals, match them with -F code
   if (!(toys.optflags & FLAG_F)) {
+    for (al = TT.e; al; al = al->next)
+      if (strpbrk(al->arg, (toys.optflags & FLAG_E) ? "\\.[*^$+?(){}|"
+        : "\\.[*^$")) break;
+    if (!al) toys.optflags |= FLAG_F;
+  }
+
+  if (toys.optflags & FLAG_F) ac_build();
+  else {
     char *regstr;
     int i;
 
@@ -302,9 +498,10 @@ static void parse_regex(void)
     }
     *(s-=(1+!(toys.optflags & FLAG_E))) = 0;
 
-    i = regcomp((regex_t *)toybuf, regstr,
-                ((toys.optflags & FLAG_E) ? REG_EXTENDED : 0) |
-                ((toys.optflags & FLAG_i) ? REG_ICASE    : 0));
+    TT.regstr = regstr;
+    TT.cflags = ((toys.optflags & FLAG_E) ? REG_EXTENDED : 0) |
+                ((toys.optflags & FLAG_i) ? REG_ICASE    : 0);
+    i = regcomp((regex_t *)toybuf, regstr, TT.cflags);
 
     if (i) {
       regerror(i, (regex_t *)toybuf, toybuf+sizeof(regex_t),
@@ -325,8 +522,11 @@ static int do_grep_r(struct dirtree *new)
   if (new->parent && !(toys.optflags & FLAG_h)) toys.optflags |= FLAG_H;
 
   name = dirtree_path(new, 0);
-  do_grep(openat(dirtree_parentfd(new), new->name, 0), name);
-  free(name);
+  if (TT.threads) grep_queue(openat(dirtree_parentfd(new), new->name, 0), name);
+  else {
+    do_grep(openat(dirtree_parentfd(new), new->name, 0), name);
+    free(name);
+  }
 
   return 0;
 }
@@ -363,10 +563,37 @@ void grep_main(void)
   }
 
   if (toys.optflags & FLAG_r) {
+    pthread_t *threads = 0;
+
+    // Start -j workers
+    if (TT.j > 1) {
+      threads = xmalloc(TT.j*sizeof(pthread_t));
+      TT.tail = &TT.jobs;
+      pthread_mutex_init(&TT.mutex, 0);
+      pthread_cond_init(&TT.cond, 0);
+      for (TT.threads = 0; TT.threads<TT.j; TT.threads++)
+        xpthread_create(threads+TT.threads, grep_worker, 0);
+    }
+
     // Iterate through -r arguments. Use "." as default if none provided.
     for (ss = *ss ? ss : (char *[]){".", 0}; *ss; ss++) {
-      if (!strcmp(*ss, "-")) do_grep(0, *ss);
-      else dirtree_read(*ss, do_grep_r);
+      if (!strcmp(*ss, "-")) {
+        if (threads) grep_emit(0);
+        do_grep(0, *ss);
+      } else dirtree_read(*ss, do_grep_r);
+    }
+
+    // Flush remaining output and wait for workers
+    if (threads) {
+      int i;
+
+      grep_emit(0);
+      pthread_mutex_lock(&TT.mutex);
+      TT.finish = 1;
+      pthread_cond_broadcast(&TT.cond);
+      pthread_mutex_unlock(&TT.mutex);
+      for (i = 0; i<TT.threads; i++) pthread_join(threads[i], 0);
+      if (CFG_TOYBOX_FREE) free(threads);
     }
   } else loopfiles_rw(ss, O_RDONLY, 0, 1, do_grep);
 }
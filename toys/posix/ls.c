@@ -320,7 +320,11 @@ static void listfiles(int dirfd, struct dirtree *indir)
     // Read directory contents. We dup() the fd because this will close it.
     // This reads/saves contents to display later, except for in "ls -1f" mode.
     indir->dirfd = dup(dirfd);
-    dirtree_recurse(indir, filter, DIRTREE_SYMFOLLOW*!!(flags&FLAG_L));
+    // Output that only needs names and file types can skip stat().
+    dirtree_recurse(indir, filter, DIRTREE_SLAB
+      |DIRTREE_SYMFOLLOW*!!(flags&FLAG_L)
+      |DIRTREE_STATLESS*!(flags&(FLAG_l|FLAG_n|FLAG_g|FLAG_o|FLAG_s|FLAG_i
+        |FLAG_t|FLAG_S|FLAG_F|FLAG_color)));
   }
 
   // Copy linked list to array and sort it. Directories go in array because
@@ -506,7 +510,7 @@ static void listfiles(int dirfd, struct dirtree *indir)
 
   // Free directory entries, recursing first if necessary.
 
-  for (ul = 0; ul<dtlen; free(sort[ul++])) {
+  for (ul = 0; ul<dtlen; dirtree_free(sort[ul++])) {
     if ((flags & FLAG_d) || !S_ISDIR(sort[ul]->st.st_mode)) continue;
 
     // Recurse into dirs if at top of the tree or given -R
@@ -54,7 +54,8 @@ static int do_rm(struct dirtree *try)
       if (toys.optflags & FLAG_f) wfchmodat(fd, try->name, 0700);
       else goto skip;
     }
-    if (!try->again) return DIRTREE_COMEAGAIN;
+    // Only need file types of children, not a stat() each.
+    if (!try->again) return DIRTREE_COMEAGAIN|DIRTREE_STATLESS;
     if (try->symlink) goto skip;
     if (flags & FLAG_i) {
       char *s = dirtree_path(try, 0);
@@ -7,7 +7,7 @@
  * Deviations from POSIX: Lots.
  * We invented -x
 
-USE_SORT(NEWTOY(sort, USE_SORT_FLOAT("g")USE_SORT_BIG("S:T:m" "o:k*t:xbMcszdfi") "run", TOYFLAG_USR|TOYFLAG_BIN))
+USE_SORT(NEWTOY(sort, USE_SORT_BIG("(parallel)#<1")USE_SORT_FLOAT("g")USE_SORT_BIG("S:T:m" "o:k*t:xbMcszdfi") "run", TOYFLAG_USR|TOYFLAG_BIN))
 
 config SORT
   bool "sort"
@@ -26,13 +26,14 @@ config SORT_BIG
   default y
   depends on SORT
   help
-    usage: sort [-bcdfiMsz] [-k#[,#[x]] [-t X]] [-o FILE]
+    usage: sort [-bcdfimMsz] [-k#[,#[x]] [-t X]] [-o FILE] [-S SIZE] [-T DIR]
 
     -b	ignore leading blanks (or trailing blanks in second part of key)
     -c	check whether input is sorted
     -d	dictionary order (use alphanumeric and whitespace chars only)
     -f	force uppercase (case insensitive sort)
     -i	ignore nonprinting characters
+    -m	merge already sorted files
     -M	month sort (jan, feb, etc).
     -x	Hexadecimal numerical sort
     -s	skip fallback sort (only sort with keys)
@@ -40,6 +41,9 @@ config SORT_BIG
     -k	sort by "key" (see below)
     -t	use a key separator other than whitespace
     -o	output to FILE instead of stdout
+    -S	memory to use before sorting in chunks on disk (Kbytes, or b, M, G, %)
+    -T	directory for temporary files (default $TMPDIR or /tmp)
+    --parallel	sort using N threads (default 1)
 
     Sorting by key looks at a subset of the words on each line.  -k2
     uses the second word to the end of the line, -k2,2 looks at only
@@ -65,11 +69,14 @@ GLOBALS(
   char *key_separator;
   struct arg_list *raw_keys;
   char *outfile;
-  char *ignore1, ignore2;   // GNU compatability NOPs for -S and -T.
+  char *tmpdir, *bufsize;
+  long parallel;
 
   void *key_list;
-  int linecount;
-  char **lines;
+  int linecount, runcount, keycount;
+  struct sort_rec **lines, *last;
+  long size, used;
+  struct sort_run *runs;
 )
 
 // The sort types are n, g, and M.
@@ -79,6 +86,28 @@ GLOBALS(
 
 #define FLAG_bb (1<<31)  // Ignore trailing blanks
 
+// A line with each key parsed out of it, string or numeric value by type.
+// For -g l is 0 for not a number, 1 for NaN, 2 for numbers and infinity.
+struct sort_rec
+{
+  char *line;
+  struct sort_val {
+    char *str;
+    double d;
+    long l;
+  } key[];
+};
+
+// A sorted temporary file (or -m input) being merged.
+struct sort_run
+{
+  FILE *fp;
+  char *line;
+  size_t size;
+  struct sort_rec *rec;
+  int level;
+};
+
 struct sort_key
 {
   struct sort_key *next_key;  // linked list
@@ -168,142 +197,422 @@ static struct sort_key *add_key(void)
   void **stupid_compiler = &TT.key_list;
   struct sort_key **pkey = (struct sort_key **)stupid_compiler;
 
+  TT.keycount++;
   while (*pkey) pkey = &((*pkey)->next_key);
   return *pkey = xzalloc(sizeof(struct sort_key));
 }
 
+// Parse a line's keys once up front, so comparisons don't have to.
+static struct sort_rec *sort_rec(char *line)
+{
+  struct sort_rec *rec = xmalloc(sizeof(struct sort_rec)
+    +TT.keycount*sizeof(struct sort_val));
+  struct sort_key *key = (struct sort_key *)TT.key_list;
+  struct sort_val *val;
+  int flags, ff;
+  char *x, *xx;
+
+  rec->line = line;
+  for (val = rec->key; key; key = key->next_key, val++) {
+    flags = key->flags ? key->flags : toys.optflags;
+    x = val->str = get_key_data(line, key, flags);
+
+    // Ascii sort keeps the string
+    if (!(ff = flags & (FLAG_n|FLAG_g|FLAG_M|FLAG_x))) continue;
+
+    if (CFG_SORT_FLOAT && ff == FLAG_g) {
+      val->d = strtod(x, &xx);
+      val->l = (x==xx) ? 0 : 1+(val->d==val->d);
+    } else if (CFG_SORT_BIG && ff == FLAG_M) {
+      struct tm thyme;
+
+      val->l = strptime(x, "%b", &thyme) ? thyme.tm_mon : -1;
+    } else if (CFG_SORT_BIG && ff == FLAG_x) val->l = strtol(x, NULL, 16);
+    // This has to be ff == FLAG_n
+    else {
+      // Full floating point version of -n
+      if (CFG_SORT_FLOAT) val->d = atof(x);
+      // Integer version of -n for tiny systems
+      else val->l = atoi(x);
+    }
+    if (x != line) free(x);
+    val->str = 0;
+  }
+
+  return rec;
+}
+
+// Free a sort_rec (but not the line it points to)
+static void sort_free(struct sort_rec *rec)
+{
+  int i;
+
+  if (!rec) return;
+  for (i = 0; i<TT.keycount; i++)
+    if (rec->key[i].str != rec->line) free(rec->key[i].str);
+  free(rec);
+}
+
 // Perform actual comparison
-static int compare_values(int flags, char *x, char *y)
+static int compare_values(int flags, struct sort_val *x, struct sort_val *y)
 {
   int ff = flags & (FLAG_n|FLAG_g|FLAG_M|FLAG_x);
 
   // Ascii sort
-  if (!ff) return ((flags&FLAG_f) ? strcasecmp : strcmp)(x, y);
+  if (!ff) return ((flags&FLAG_f) ? strcasecmp : strcmp)(x->str, y->str);
 
+  // not numbers < NaN < -infinity < numbers < +infinity
   if (CFG_SORT_FLOAT && ff == FLAG_g) {
-    char *xx,*yy;
-    double dx = strtod(x,&xx), dy = strtod(y,&yy);
-    int xinf, yinf;
+    if (x->l != y->l) return x->l-y->l;
+    if (x->l != 2) return 0;
+  } else if (!CFG_SORT_FLOAT || ff != FLAG_n)
+    return (x->l>y->l)-(x->l<y->l);
+
+  return (x->d>y->d)-(x->d<y->d);
+}
+
+// Callback from qsort(): Iterate through key_list and perform comparisons.
+static int compare_keys(const void *xarg, const void *yarg)
+{
+  int flags = toys.optflags, retval = 0, i = 0;
+  struct sort_rec *xx = *(struct sort_rec **)xarg,
+    *yy = *(struct sort_rec **)yarg;
+  struct sort_key *key;
+
+  for (key=(struct sort_key *)TT.key_list; key; key = key->next_key, i++) {
+    flags = key->flags ? key->flags : toys.optflags;
+    if ((retval = compare_values(flags, xx->key+i, yy->key+i))) break;
+  }
 
-    // not numbers < NaN < -infinity < numbers < +infinity
+  // Perform fallback sort if necessary (always case insensitive, no -f,
+  // the point is to get a stable order even for -f sorts)
+  if (!retval && !(CFG_SORT_BIG && (toys.optflags&FLAG_s))) {
+    flags = toys.optflags;
+    retval = strcmp(xx->line, yy->line);
+  }
 
-    if (x==xx) return y==yy ? 0 : -1;
-    if (y==yy) return 1;
+  return retval * ((flags&FLAG_r) ? -1 : 1);
+}
+
+// Merge sorted runs a[0..mid) and a[mid..len) into out, keeping equal
+// records in order.
+static void sort_merge2(struct sort_rec **a, long mid, long len,
+  struct sort_rec **out)
+{
+  long i = 0, j = mid;
 
-    // Check for isnan
-    if (dx!=dx) return (dy!=dy) ? 0 : -1;
-    if (dy!=dy) return 1;
+  while (i<mid && j<len)
+    *out++ = (compare_keys(a+j, a+i)<0) ? a[j++] : a[i++];
+  memcpy(out, a+i, (mid-i)*sizeof(*a));
+  memcpy(out+mid-i, a+j, (len-j)*sizeof(*a));
+}
 
-    // Check for infinity.  (Could underflow, but avoids needing libm.)
-    xinf = (1.0/dx == 0.0);
-    yinf = (1.0/dy == 0.0);
-    if (xinf) {
-      if(dx<0) return (yinf && dy<0) ? 0 : -1;
-      return (yinf && dy>0) ? 0 : 1;
+// Stable merge sort of a, where b starts as a copy of a. Each level sorts
+// the halves into the other array and merges them back.
+static void sort_msort(struct sort_rec **a, struct sort_rec **b, long len)
+{
+  long i, j, mid = len/2;
+  struct sort_rec *rec;
+
+  // insertion sort small runs
+  if (len<8) {
+    for (i = 1; i<len; i++) {
+      for (rec = a[j = i]; j && compare_keys(a+j-1, &rec)>0; j--) a[j] = a[j-1];
+      a[j] = rec;
     }
-    if (yinf) return dy<0 ? 1 : -1;
-
-    return dx>dy ? 1 : (dx<dy ? -1 : 0);
-  } else if (CFG_SORT_BIG && ff == FLAG_M) {
-    struct tm thyme;
-    int dx;
-    char *xx,*yy;
-
-    xx = strptime(x,"%b",&thyme);
-    dx = thyme.tm_mon;
-    yy = strptime(y,"%b",&thyme);
-    if (!xx) return !yy ? 0 : -1;
-    else if (!yy) return 1;
-    else return dx==thyme.tm_mon ? 0 : dx-thyme.tm_mon;
-
-  } else if (CFG_SORT_BIG && ff == FLAG_x) {
-    return strtol(x, NULL, 16)-strtol(y, NULL, 16);
-  // This has to be ff == FLAG_n
   } else {
-    // Full floating point version of -n
-    if (CFG_SORT_FLOAT) {
-      double dx = atof(x), dy = atof(y);
+    sort_msort(b, a, mid);
+    sort_msort(b+mid, a+mid, len-mid);
+    sort_merge2(b, mid, len, a);
+  }
+}
+
+// A chunk of records for a thread to sort (mid = 0), or merge from a to b.
+struct sort_job {
+  struct sort_rec **a, **b;
+  long mid, len;
+  pthread_t thread;
+};
+
+static void *sort_thread(void *arg)
+{
+  struct sort_job *job = arg;
+
+  if (job->mid) sort_merge2(job->a, job->mid, job->len, job->b);
+  else sort_msort(job->a, job->b, job->len);
+
+  return 0;
+}
+
+// Run jobs, the first one in this thread and the rest in their own.
+static void sort_jobs(struct sort_job *jobs, long count)
+{
+  long i;
+
+  for (i = 1; i<count; i++)
+    xpthread_create(&jobs[i].thread, sort_thread, jobs+i);
+  sort_thread(jobs);
+  for (i = 1; i<count; i++) pthread_join(jobs[i].thread, 0);
+}
 
-      return dx>dy ? 1 : (dx<dy ? -1 : 0);
-    // Integer version of -n for tiny systems
-    } else return atoi(x)-atoi(y);
+// Sort TT.lines: --parallel threads each sort a chunk, then adjacent chunks
+// are merged pairwise (also in parallel) until there's one left.
+static void sort_lines(void)
+{
+  long n = TT.linecount, count = TT.parallel, i, j;
+  struct sort_rec **a = TT.lines, **b = xmalloc(n*sizeof(*b)), **swap;
+  struct sort_job *jobs;
+
+  // Don't bother with threads for less than a few thousand lines each
+  if (count>n/4096) count = n/4096;
+  if (count<1) count = 1;
+  jobs = xmalloc(count*sizeof(struct sort_job));
+  memcpy(b, a, n*sizeof(*b));
+  for (i = 0; i<count; i++) {
+    j = n*i/count;
+    jobs[i] = (struct sort_job){a+j, b+j, 0, n*(i+1)/count-j};
+  }
+  sort_jobs(jobs, count);
+
+  for (; count>1; count = j) {
+    for (i = j = 0; i<count; i += 2, j++) {
+      struct sort_job *job = jobs+j, *next = jobs+i+1;
+
+      job->a = jobs[i].a;
+      job->b = b+(job->a-a);
+      job->mid = jobs[i].len;
+      if (i+1<count) job->len = job->mid+next->len;
+      else {
+        // Odd one out just gets copied
+        memcpy(job->b, job->a, (job->len = job->mid)*sizeof(*a));
+        job->mid = 0;
+      }
+    }
+    sort_jobs(jobs, j-!jobs[j-1].mid);
+    for (i = 0; i<j; i++) jobs[i].a = jobs[i].b;
+    swap = a;
+    a = b;
+    b = swap;
   }
+  TT.lines = a;
+  free(b);
+  free(jobs);
 }
 
-// Callback from qsort(): Iterate through key_list and perform comparisons.
-static int compare_keys(const void *xarg, const void *yarg)
+// Write a line to output, with terminator.
+static void sort_line(FILE *fp, char *s)
 {
-  int flags = toys.optflags, retval = 0;
-  char *x, *y, *xx = *(char **)xarg, *yy = *(char **)yarg;
-  struct sort_key *key;
+  fputs(s, fp);
+  putc((toys.optflags&FLAG_z) ? 0 : '\n', fp);
+}
 
-  if (CFG_SORT_BIG) {
-    for (key=(struct sort_key *)TT.key_list; !retval && key;
-       key = key->next_key)
-    {
-      flags = key->flags ? key->flags : toys.optflags;
+// Read next line of a run, returning 0 at EOF.
+static int sort_next(struct sort_run *run)
+{
+  int z = toys.optflags&FLAG_z;
+  ssize_t len = getdelim(&run->line, &run->size, z ? 0 : '\n', run->fp);
 
-      // Chop out and modify key chunks, handling -dfib
+  if (len<1) {
+    if (ferror(run->fp)) perror_exit("read");
+    return 0;
+  }
+  if (!z && run->line[len-1]=='\n') run->line[len-1] = 0;
+  sort_free(run->rec);
+  run->rec = sort_rec(run->line);
 
-      x = get_key_data(xx, key, flags);
-      y = get_key_data(yy, key, flags);
+  return 1;
+}
 
-      retval = compare_values(flags, x, y);
+// Order runs by current line, ties go to the earlier run.
+static int sort_runcmp(struct sort_run *a, struct sort_run *b)
+{
+  int i = compare_keys(&a->rec, &b->rec);
 
-      // Free the copies get_key_data() made.
+  return i ? i : (a>b)-(a<b);
+}
 
-      if (x != xx) free(x);
-      if (y != yy) free(y);
+// Move heap[i] down to where it belongs in a heap of n runs
+static void sort_sift(struct sort_run **heap, int n, int i)
+{
+  struct sort_run *run = heap[i];
+  int j;
+
+  for (; (j = 2*i+1)<n; i = j) {
+    if (j+1<n && sort_runcmp(heap[j+1], heap[j])<0) j++;
+    if (sort_runcmp(run, heap[j])<=0) break;
+    heap[i] = heap[j];
+  }
+  heap[i] = run;
+}
 
-      if (retval) break;
+// Merge sorted runs to out, closing them as they run out.
+static void sort_merge(struct sort_run *runs, int count, FILE *out, int uniq)
+{
+  struct sort_run **heap = xmalloc(count*sizeof(*heap)), *run;
+  struct sort_rec *last = 0, *swap;
+  char *lastline = 0;
+  size_t lastsize = 0, size;
+  int i, n = 0;
+
+  for (i = 0; i<count; i++) {
+    if (sort_next(runs+i)) heap[n++] = runs+i;
+    else fclose(runs[i].fp);
+  }
+  for (i = n/2; i--;) sort_sift(heap, n, i);
+
+  while (n) {
+    run = *heap;
+    if (!uniq || !last || compare_keys(&last, &run->rec)) {
+      sort_line(out, run->line);
+
+      // Keep this line to compare against, recycling the old buffer.
+      if (uniq) {
+        swap = last;
+        last = run->rec;
+        run->rec = swap;
+        run->line = lastline;
+        lastline = last->line;
+        size = lastsize;
+        lastsize = run->size;
+        run->size = size;
+      }
+    }
+    if (!sort_next(run)) {
+      fclose(run->fp);
+      *heap = heap[--n];
     }
-  } else retval = compare_values(flags, xx, yy);
+    if (n) sort_sift(heap, n, 0);
+  }
+  for (i = 0; i<count; i++) {
+    sort_free(runs[i].rec);
+    free(runs[i].line);
+  }
+  sort_free(last);
+  free(lastline);
+  free(heap);
+}
 
-  // Perform fallback sort if necessary (always case insensitive, no -f,
-  // the point is to get a stable order even for -f sorts)
-  if (!retval && !(CFG_SORT_BIG && (toys.optflags&FLAG_s))) {
-    flags = toys.optflags;
-    retval = strcmp(xx, yy);
+// Create an anonymous temporary file under -T
+static FILE *sort_tempfile(void)
+{
+  char *name = xmprintf("%s/sortXXXXXX", TT.tmpdir);
+  int fd = mkstemp(name);
+
+  if (fd == -1) perror_exit("%s", name);
+  unlink(name);
+  free(name);
+
+  return xfdopen(fd, "w+");
+}
+
+// Add a sorted file to the list of runs (level -1 is a -m input, else a
+// temporary file to rewind). When 16 runs of the same level pile up they're
+// merged into one run of the next level, so each line gets rewritten
+// log16(runs) times and we don't run out of filehandles.
+static void sort_addrun(FILE *fp, int level)
+{
+  struct sort_run *run;
+
+  if (level>=0) {
+    if (fflush(fp) || ferror(fp)) perror_exit("write");
+    rewind(fp);
   }
+  if (!(TT.runcount&15))
+    TT.runs = xrealloc(TT.runs, sizeof(struct sort_run)*(TT.runcount+16));
+  run = TT.runs+TT.runcount++;
+  memset(run, 0, sizeof(struct sort_run));
+  run->fp = fp;
+  run->level = level;
+
+  if (TT.runcount>=16 && TT.runs[TT.runcount-16].level == level) {
+    TT.runcount -= 16;
+    sort_merge(TT.runs+TT.runcount, 16, fp = sort_tempfile(), 0);
+    sort_addrun(fp, level+1);
+  }
+}
 
-  return retval * ((flags&FLAG_r) ? -1 : 1);
+// Sort the lines in memory and write them out as a new run.
+static void sort_spill(void)
+{
+  FILE *fp = sort_tempfile();
+  int i;
+
+  sort_lines();
+  for (i = 0; i<TT.linecount; i++) {
+    sort_line(fp, TT.lines[i]->line);
+    free(TT.lines[i]->line);
+    sort_free(TT.lines[i]);
+  }
+  TT.linecount = TT.used = 0;
+  sort_addrun(fp, 0);
 }
 
 // Callback from loopfiles to handle input files.
 static void sort_read(int fd, char *name)
 {
+  struct linebuf *lb = linebuf_new(fd);
+  char end = (CFG_SORT_BIG && (toys.optflags&FLAG_z)) ? 0 : '\n';
+
   // Read each line from file, appending to a big array.
 
   for (;;) {
-    char * line = (CFG_SORT_BIG && (toys.optflags&FLAG_z))
-             ? get_rawline(fd, NULL, 0) : get_line(fd);
+    long len;
+    char *line = linebuf_line(lb, &len, end);
+    struct sort_rec *rec;
 
     if (!line) break;
+    if (end && line[len-1] == end) line[len-1] = 0;
+    rec = sort_rec(line);
 
     // handle -c here so we don't allocate more memory than necessary.
     if (CFG_SORT_BIG && (toys.optflags&FLAG_c)) {
       int j = (toys.optflags&FLAG_u) ? -1 : 0;
 
-      if (TT.lines && compare_keys((void *)&TT.lines, &line)>j)
+      if (TT.last && compare_keys(&TT.last, &rec)>j)
         error_exit("%s: Check line %d\n", name, TT.linecount);
-      free(TT.lines);
-      TT.lines = (char **)line;
+      if (TT.last) free(TT.last->line);
+      sort_free(TT.last);
+      TT.last = rec;
     } else {
       if (!(TT.linecount&63))
-        TT.lines = xrealloc(TT.lines, sizeof(char *)*(TT.linecount+64));
-      TT.lines[TT.linecount] = line;
+        TT.lines = xrealloc(TT.lines, sizeof(rec)*(TT.linecount+64));
+      TT.lines[TT.linecount] = rec;
+
+      // With -S, count line, record, malloc overhead, and pointers to it.
+      if (TT.size && (TT.used += strlen(line)+1+sizeof(struct sort_rec)
+          +TT.keycount*sizeof(struct sort_val)+4*sizeof(char *))>TT.size)
+      {
+        TT.linecount++;
+        sort_spill();
+        continue;
+      }
     }
     TT.linecount++;
   }
+  linebuf_free(lb);
 }
 
 void sort_main(void)
 {
   int idx, fd = 1;
+  FILE *out = stdout;
 
   // Open output file if necessary.
   if (CFG_SORT_BIG && TT.outfile)
-    fd = xcreate(TT.outfile, O_CREAT|O_TRUNC|O_WRONLY, 0666);
+    out = xfdopen(fd = xcreate(TT.outfile, O_CREAT|O_TRUNC|O_WRONLY, 0666),
+      "w");
+
+  // Size of memory buffer: default units are kilobytes, % of physical memory
+  if (CFG_SORT_BIG && TT.bufsize) {
+    char *end;
+
+    TT.size = strtol(TT.bufsize, &end, 10);
+    if (!*end) TT.size *= 1024;
+    else if (!strcmp(end, "%"))
+      TT.size = sysconf(_SC_PHYS_PAGES)/100*TT.size*sysconf(_SC_PAGESIZE);
+    else TT.size = atolx(TT.bufsize);
+  }
+  if (!TT.tmpdir && !(TT.tmpdir = getenv("TMPDIR"))) TT.tmpdir = "/tmp";
 
   // Parse -k sort keys.
   if (CFG_SORT_BIG && TT.raw_keys) {
@@ -333,10 +642,10 @@ void sort_main(void)
             break;
           }
 
-          // Which flag is this?
+          // Which flag is this? (Last match, long options come first.)
 
           optlist = toys.which->options;
-          temp2 = strchr(optlist, *temp);
+          temp2 = strrchr(optlist, *temp);
           flag = (1<<(optlist-temp2+strlen(optlist)-1));
 
           // Was it a flag that can apply to a key?
@@ -358,7 +667,18 @@ void sort_main(void)
   if (toys.optflags&FLAG_b) toys.optflags |= FLAG_bb;
 
   // If no keys, perform alphabetic sort over the whole line.
-  if (CFG_SORT_BIG && !TT.key_list) add_key()->range[0] = 1;
+  if (!TT.key_list) add_key()->range[0] = 1;
+
+  // Merge already sorted inputs without reading them into memory.
+  if (CFG_SORT_BIG && (toys.optflags&(FLAG_m|FLAG_c)) == FLAG_m) {
+    char *stdin_name[] = {"-", 0}, **arg = *toys.optargs ? toys.optargs
+      : stdin_name;
+
+    for (; *arg; arg++) sort_addrun(strcmp(*arg, "-") ? xfopen(*arg, "r")
+      : stdin, -1);
+    sort_merge(TT.runs, TT.runcount, out, toys.optflags&FLAG_u);
+    goto exit_now;
+  }
 
   // Open input files and read data, populating TT.lines[TT.linecount]
   loopfiles(toys.optargs, sort_read);
@@ -367,34 +687,43 @@ void sort_main(void)
   // so if we got here, we're done.
   if (CFG_SORT_BIG && (toys.optflags&FLAG_c)) goto exit_now;
 
+  // If -S spilled sorted runs to disk, merge them.
+  if (TT.runcount) {
+    if (TT.linecount) sort_spill();
+    sort_merge(TT.runs, TT.runcount, out, toys.optflags&FLAG_u);
+    goto exit_now;
+  }
+
   // Perform the actual sort
-  qsort(TT.lines, TT.linecount, sizeof(char *), compare_keys);
+  sort_lines();
 
   // handle unique (-u)
   if (toys.optflags&FLAG_u) {
     int jdx;
 
     for (jdx=0, idx=1; idx<TT.linecount; idx++) {
-      if (!compare_keys(&TT.lines[jdx], &TT.lines[idx]))
-        free(TT.lines[idx]);
-      else TT.lines[++jdx] = TT.lines[idx];
+      if (!compare_keys(&TT.lines[jdx], &TT.lines[idx])) {
+        free(TT.lines[idx]->line);
+        sort_free(TT.lines[idx]);
+      } else TT.lines[++jdx] = TT.lines[idx];
     }
     if (TT.linecount) TT.linecount = jdx+1;
   }
 
   // Output result
   for (idx = 0; idx<TT.linecount; idx++) {
-    char *s = TT.lines[idx];
-    unsigned i = strlen(s);
-
-    if (!(toys.optflags&FLAG_z)) s[i] = '\n';
-    xwrite(fd, s, i+1);
-    if (CFG_TOYBOX_FREE) free(s);
+    sort_line(out, TT.lines[idx]->line);
+    if (CFG_TOYBOX_FREE) {
+      free(TT.lines[idx]->line);
+      sort_free(TT.lines[idx]);
+    }
   }
 
 exit_now:
+  if (fflush(out) || ferror(out)) perror_exit("write");
   if (CFG_TOYBOX_FREE) {
-    if (fd != 1) close(fd);
+    if (fd != 1) fclose(out);
     free(TT.lines);
+    free(TT.runs);
   }
 }
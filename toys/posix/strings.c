@@ -27,38 +27,44 @@ config STRINGS
 
 GLOBALS(
   long num;
+
+  char *string, *filename;
+  off_t offset;
+  long count;
 )
 
-static void do_strings(int fd, char *filename)
+// Callback for loopchunks()
+static void strings_chunk(char *data, long len)
 {
-  int nread, i, wlen = TT.num, count = 0;
-  off_t offset = 0;
-  char *string = xzalloc(wlen + 1);
+  long i, wlen = TT.num;
 
-  for (;;) {
-    nread = read(fd, toybuf, sizeof(toybuf));
-    if (nread < 0) perror_msg_raw(filename);
-    if (nread < 1) break;
-    for (i = 0; i < nread; i++, offset++) {
-      if (((toybuf[i] >= 32) && (toybuf[i] <= 126)) || (toybuf[i] == '\t')) {
-        if (count == wlen) fputc(toybuf[i], stdout);
-        else {
-          string[count++] = toybuf[i];
-          if (count == wlen) {
-            if (toys.optflags & FLAG_f) printf("%s: ", filename);
-            if (toys.optflags & FLAG_o)
-              printf("%7lld ",(long long)(offset - wlen));
-            printf("%s", string);
-          }
+  for (i = 0; i < len; i++, TT.offset++) {
+    if (((data[i] >= 32) && (data[i] <= 126)) || (data[i] == '\t')) {
+      if (TT.count == wlen) fputc(data[i], stdout);
+      else {
+        TT.string[TT.count++] = data[i];
+        if (TT.count == wlen) {
+          if (toys.optflags & FLAG_f) printf("%s: ", TT.filename);
+          if (toys.optflags & FLAG_o)
+            printf("%7lld ",(long long)(TT.offset - wlen));
+          printf("%s", TT.string);
         }
-      } else {
-        if (count == wlen) xputc('\n');
-        count = 0;
       }
+    } else {
+      if (TT.count == wlen) xputc('\n');
+      TT.count = 0;
     }
   }
+}
+
+static void do_strings(int fd, char *filename)
+{
+  TT.string = xzalloc(TT.num + 1);
+  TT.filename = filename;
+  TT.offset = TT.count = 0;
+  loopchunks(fd, filename, strings_chunk);
   xclose(fd);
-  free(string);
+  free(TT.string);
 }
 
 void strings_main(void)
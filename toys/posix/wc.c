@@ -26,9 +26,15 @@ config WC
 
 #define FOR_wc
 #include "toys.h"
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 
 GLOBALS(
-  unsigned long totals[3];
+  unsigned long totals[3], lengths[3];
+  int word, partial, fast;
 )
 
 static void show_lengths(unsigned long *lengths, char *name)
@@ -45,59 +51,169 @@ static void show_lengths(unsigned long *lengths, char *name)
   xputc('\n');
 }
 
+// Return bitmask of whitespace (ascii isspace()) bytes in 16 bytes at p, and
+// set *nl to mask of newlines and *hi to mask of bytes with the high bit set.
+static unsigned wc_mask(char *p, unsigned *nl, unsigned *hi)
+{
+#if defined(__SSE2__)
+  __m128i x = _mm_loadu_si128((void *)p), c = _mm_sub_epi8(x, _mm_set1_epi8(9)),
+    n = _mm_cmpeq_epi8(x, _mm_set1_epi8('\n'));
+
+  *nl = _mm_movemask_epi8(n);
+  *hi = _mm_movemask_epi8(x);
+
+  // 9-13 is \t\n\v\f\r: unsigned (x-9)<5 via min(), sse2 has no unsigned <
+  return _mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi8(x, _mm_set1_epi8(' ')),
+    _mm_cmpeq_epi8(_mm_min_epu8(c, _mm_set1_epi8(4)), c)));
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  static const uint8_t bits[16] = {1,2,4,8,16,32,64,128,1,2,4,8,16,32,64,128};
+  uint8x16_t x = vld1q_u8((void *)p), b = vld1q_u8(bits), s;
+
+  // No movemask, so AND each lane with its bit and add up each half.
+#define MASK(v) (vaddv_u8(vget_low_u8(vandq_u8(v, b))) \
+  | (vaddv_u8(vget_high_u8(vandq_u8(v, b)))<<8))
+  s = vorrq_u8(vceqq_u8(x, vdupq_n_u8(' ')),
+    vcltq_u8(vsubq_u8(x, vdupq_n_u8(9)), vdupq_n_u8(5)));
+  *nl = MASK(vceqq_u8(x, vdupq_n_u8('\n')));
+  *hi = MASK(vcltzq_s8(vreinterpretq_s8_u8(x)));
+
+  return MASK(s);
+#undef MASK
+#else
+  unsigned i, sp = 0;
+
+  *nl = *hi = 0;
+  for (i = 0; i<16; i++) {
+    unsigned char c = p[i];
+
+    *nl |= (c=='\n')<<i;
+    *hi |= (c>>7)<<i;
+    sp |= (c==' ' || (unsigned char)(c-9)<5)<<i;
+  }
+
+  return sp;
+#endif
+}
+
+// Count newlines, for plain -l.
+static unsigned long wc_lines(char *p, long len)
+{
+  unsigned long count = 0;
+  long i = 0;
+
+#if defined(__SSE2__)
+  __m128i nl = _mm_set1_epi8('\n'), zero = _mm_setzero_si128();
+
+  // cmpeq gives -1 per match, so subtracting counts up to 255 per byte lane
+  // before we have to add the lanes up (with sad, against zero).
+  while (len-i>=16) {
+    __m128i acc = zero, sum;
+    int j;
+
+    for (j = 0; j<255 && len-i>=16; j++, i += 16)
+      acc = _mm_sub_epi8(acc,
+        _mm_cmpeq_epi8(_mm_loadu_si128((void *)(p+i)), nl));
+    sum = _mm_sad_epu8(acc, zero);
+    count += _mm_cvtsi128_si32(sum)+_mm_extract_epi16(sum, 4);
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  uint8x16_t nl = vdupq_n_u8('\n');
+
+  while (len-i>=16) {
+    uint8x16_t acc = vdupq_n_u8(0);
+    int j;
+
+    for (j = 0; j<255 && len-i>=16; j++, i += 16)
+      acc = vsubq_u8(acc, vceqq_u8(vld1q_u8((void *)(p+i)), nl));
+    count += vaddlvq_u8(acc);
+  }
+#endif
+  for (; i<len; i++) count += p[i]=='\n';
+
+  return count;
+}
+
+// Callback for loopchunks()
+static void wc_chunk(char *data, long len)
+{
+  long i;
+  int clen = 1, space, mflag = CFG_TOYBOX_I18N && (toys.optflags&FLAG_m);
+
+  if (toys.optflags == FLAG_c) {
+    TT.lengths[2] += len;
+    return;
+  }
+  if (toys.optflags == FLAG_l) {
+    TT.lengths[0] += wc_lines(data, len);
+    return;
+  }
+  for (i=0; i<len; i+=clen) {
+    wchar_t wchar;
+
+    // 16 bytes at a time unless locale has high whitespace or we're in the
+    // middle of a multibyte character. For -m, only all-ascii blocks.
+    if (TT.fast && !TT.partial && len-i>=16) {
+      unsigned nl, hi, sp = wc_mask(data+i, &nl, &hi);
+
+      if (!mflag || !hi) {
+        TT.lengths[0] += __builtin_popcount(nl);
+        TT.lengths[1] += __builtin_popcount(~sp & 0xffff & ((sp<<1)|!TT.word));
+        TT.lengths[2] += 16;
+        TT.word = !(sp>>15);
+        clen = 16;
+        continue;
+      }
+    }
+
+    clen = 1;
+    if (mflag) {
+      clen = mbrtowc(&wchar, data+i, len-i, 0);
+      if ((TT.partial = (clen == -2))) break;
+      if (clen == -1) {
+        clen = 1;
+        continue;
+      }
+      if (clen == 0) clen=1;
+      space = iswspace(wchar);
+    } else space = isspace(data[i]);
+
+    if (data[i]==10) TT.lengths[0]++;
+    if (space) TT.word=0;
+    else {
+      if (!TT.word) TT.lengths[1]++;
+      TT.word=1;
+    }
+    TT.lengths[2]++;
+  }
+}
+
 static void do_wc(int fd, char *name)
 {
-  int i, len, clen=1, space;
-  unsigned long word=0, lengths[]={0,0,0};
+  memset(TT.lengths, 0, sizeof(TT.lengths));
+  TT.word = TT.partial = 0;
 
   if (toys.optflags == FLAG_c) {
     struct stat st;
 
     // On Linux, files in /proc often report their size as 0.
     if (!fstat(fd, &st) && S_ISREG(st.st_mode) && st.st_size > 0) {
-      lengths[2] = st.st_size;
+      TT.lengths[2] = st.st_size;
       goto show;
     }
   }
 
-  for (;;) {
-    len = read(fd, toybuf, sizeof(toybuf));
-    if (len<0) perror_msg_raw(name);
-    if (len<1) break;
-    if (toys.optflags == FLAG_c) {
-      lengths[2] += len;
-      continue;
-    }
-    for (i=0; i<len; i+=clen) {
-      wchar_t wchar;
-
-      if (CFG_TOYBOX_I18N && (toys.optflags&FLAG_m)) {
-        clen = mbrtowc(&wchar, toybuf+i, len-i, 0);
-        if (clen == -1) {
-          clen = 1;
-          continue;
-        }
-        if (clen == -2) break;
-        if (clen == 0) clen=1;
-        space = iswspace(wchar);
-      } else space = isspace(toybuf[i]);
-
-      if (toybuf[i]==10) lengths[0]++;
-      if (space) word=0;
-      else {
-        if (!word) lengths[1]++;
-        word=1;
-      }
-      lengths[2]++;
-    }
-  }
+  loopchunks(fd, name, wc_chunk);
 
 show:
-  show_lengths(lengths, name);
+  show_lengths(TT.lengths, name);
 }
 
 void wc_main(void)
 {
+  int i;
+
+  // The fast path only knows about ascii whitespace.
+  for (TT.fast = 1, i = 128; i<256; i++) if (isspace(i)) TT.fast = 0;
   toys.optflags |= (toys.optflags&8)>>1;
   loopfiles(toys.optargs, do_wc);
   if (toys.optc>1) show_lengths(TT.totals, "total");
@@ -6,17 +6,19 @@
  *
  * TODO: Rich's whitespace objection, env size isn't fixed anymore.
 
-USE_XARGS(NEWTOY(xargs, "^I:E:L#ptxrn#<1s#0", TOYFLAG_USR|TOYFLAG_BIN))
+USE_XARGS(NEWTOY(xargs, "^P#<0=1I:E:L#<1ptxrn#<1s#0", TOYFLAG_USR|TOYFLAG_BIN))
 
 config XARGS
   bool "xargs"
   default y
   help
-    usage: xargs [-ptxr0] [-s NUM] [-n NUM] [-L NUM] [-E STR] COMMAND...
+    usage: xargs [-ptxr0] [-s NUM] [-n NUM] [-L NUM] [-P NUM] [-E STR] COMMAND...
 
     Run command line one or more times, appending arguments from stdin.
 
     If command exits with 255, don't launch another even if arguments remain.
+    Exits 123 if any command failed, 124 for 255, 125 if killed by a signal,
+    126 if command couldn't be run, 127 if it wasn't found.
 
     -s	Size in bytes per command line
     -n	Max number of arguments per command
@@ -25,7 +27,9 @@ config XARGS
     #-t	Trace, print command line to stderr
     #-x	Exit if can't fit everything in one command
     #-r	Don't run command with empty input
-    #-L	Max number of lines of input per command
+    -L	Max number of (non-blank) lines of input per command (a line ending
+    	with a blank continues onto the next)
+    -P	Run up to NUM commands at once (0 = no limit, default 1)
     -E	stop at line matching string
 
 config XARGS_PEDANTIC
@@ -46,8 +50,10 @@ GLOBALS(
   long L;
   char *eofstr;
   char *I;
+  long P;
 
-  long entries, bytes;
+  long entries, bytes, running;
+  int err;
   char delim;
 )
 
@@ -106,11 +112,43 @@ static char *handle_entries(char *data, char **entry)
   return NULL;
 }
 
+// Wait for a command to exit, returning 1 if we shouldn't launch any more.
+
+static int xargs_wait(void)
+{
+  int status;
+
+  if (0>waitpid(-1, &status, 0)) return 1;
+  TT.running--;
+  if (WIFSIGNALED(status)) toys.exitval = 125;
+  else if (!(status = WEXITSTATUS(status))) return 0;
+  else if (status == 255) toys.exitval = 124;
+  else {
+    if (!toys.exitval) toys.exitval = 123;
+
+    return 0;
+  }
+
+  return 1;
+}
+
+// Child half of vfork(), which shares the parent's memory until _exit(),
+// so an exec failure can tell it why.
+
+static void xargs_exec(char **argv)
+{
+  xclose(0);
+  open("/dev/null", O_RDONLY);
+  execvp(*argv, argv);
+  TT.err = errno;
+  _exit(127);
+}
+
 void xargs_main(void)
 {
   struct double_list *dlist = NULL, *dtemp;
-  int entries, bytes, done = 0, status;
-  char *data = NULL, **out;
+  int entries, bytes, lines, old, done = 0, stop = 0, ran = 0;
+  char *data = NULL, *line, **out;
   pid_t pid;
 
   if (!(toys.optflags & FLAG_0)) TT.delim = '\n';
@@ -127,7 +165,7 @@ void xargs_main(void)
 
   // Loop through exec chunks.
   while (data || !done) {
-    TT.entries = 0;
+    TT.entries = lines = 0;
     TT.bytes = bytes;
 
     // Loop reading input
@@ -146,9 +184,17 @@ void xargs_main(void)
       }
       dlist_add(&dlist, data);
 
-      // Count data used
-      data = handle_entries(data, NULL);
-      if (!data) continue;
+      // Count data used, and non-blank lines for -L (where a trailing blank
+      // continues the line)
+      old = TT.entries;
+      data = handle_entries(line = data, NULL);
+      if (!data) {
+        if (TT.entries == old) continue;
+        if (TT.delim && (line = strchr(line, 0))[-1] == '\n') line--;
+        if (TT.delim && (line[-1] == ' ' || line[-1] == '\t')) continue;
+        if (++lines != TT.L) continue;
+        break;
+      }
       if (data == (char *)2) done++;
       if ((long)data <= 2) data = 0;
       else data = xstrdup(data);
@@ -158,7 +204,10 @@ void xargs_main(void)
 
     // Accumulate cally thing
 
-    if (data && !TT.entries) error_exit("argument too long");
+    if (data && !TT.entries) {
+      while (TT.running) xargs_wait();
+      error_exit("argument too long");
+    }
     out = xzalloc((entries+TT.entries+1)*sizeof(char *));
 
     // Fill out command line to exec
@@ -169,13 +218,25 @@ void xargs_main(void)
     for (dtemp = dlist; dtemp; dtemp = dtemp->next)
       handle_entries(dtemp->data, out+entries);
 
-    if (!(pid = XVFORK())) {
-      xclose(0);
-      open("/dev/null", O_RDONLY);
-      xexec(out);
+    // Wait for a free slot, stopping if a command said to. Only run with no
+    // arguments if input was empty.
+    while (!stop && TT.P && TT.running >= TT.P) stop = xargs_wait();
+    if (stop) {
+      data = 0;
+      done++;
+    } else if (TT.entries || !ran) {
+      if (!(pid = XVFORK())) xargs_exec(out);
+      TT.running++;
+      ran++;
+      if (TT.err) {
+        errno = TT.err;
+        perror_msg("exec %s", *out);
+        toys.exitval = 126+(errno == ENOENT);
+        data = 0;
+        done++;
+        stop++;
+      }
     }
-    waitpid(pid, &status, 0);
-    status = WIFEXITED(status) ? WEXITSTATUS(status) : WTERMSIG(status)+127;
 
     // Abritrary number of execs, can't just leak memory each time...
     while (dlist) {
@@ -187,4 +248,5 @@ void xargs_main(void)
     }
     free(out);
   }
+  while (TT.running) xargs_wait();
 }